@@ -37,6 +37,7 @@ SUCH DAMAGE.
 
 #include <cstdlib>
 #include <string>
+#include <vector>
 #include "Fixed.hpp"
 
 #ifndef SEPERATOR
@@ -47,6 +48,46 @@ namespace BigInt
  {
 
 
+    /*
+      Nearly every Fixed operation rescales by a power of ten, so they are
+      kept instead of being recomputed with pow() every time. 10^n for n
+      below DensePowers is in densePowers[n], and is filled in on demand.
+      Bigger powers are put together from a dense power and the blocks
+      10^(DensePowers * 2^k), which are squared up as they are needed.
+
+      The Integer reference counts are not atomic, so threads can't share
+      one Integer. Instead, each thread gets its own cache.
+    */
+   const static unsigned long DensePowers = 1024;
+
+   static thread_local std::vector<Integer> densePowers, blockPowers;
+
+   static Integer powerOfTen (unsigned long n)
+    {
+      if (densePowers.empty()) densePowers.push_back(Integer(1));
+
+      unsigned long dense = n % DensePowers, blocks = n / DensePowers;
+      while (densePowers.size() <= ((blocks == 0) ? dense : DensePowers - 1))
+         densePowers.push_back(densePowers.back() * Integer(10));
+
+      Integer result (densePowers[dense]);
+
+      for (unsigned long k = 0; blocks != 0; blocks >>= 1, k++)
+       {
+         if (blockPowers.size() <= k)
+          {
+            if (k == 0)
+               blockPowers.push_back(densePowers.back() * Integer(10));
+            else
+               blockPowers.push_back(blockPowers[k - 1] * blockPowers[k - 1]);
+          }
+         if (blocks & 1) result *= blockPowers[k];
+       }
+
+      return result;
+    }
+
+
    unsigned long Fixed::defPrec = 7;
 
    Fixed_Round_Mode Fixed::mode = ROUND_TIES_EVEN;
@@ -221,7 +262,7 @@ namespace BigInt
       d = r.Data;
       d.abs();
 
-      q.Data *= pow(Integer(10), Integer((long) (2 * r.Digits)));
+      q.Data *= powerOfTen(2 * r.Digits);
       q.Digits += r.Digits;
 
       quotrem(q.Data, r.Data, q.Data, r.Data);
@@ -247,12 +288,12 @@ namespace BigInt
       if (newPrec == Digits) return;
       if (newPrec > Digits)
        {
-         scale = pow(Integer(10), Integer((long) (newPrec - Digits)));
+         scale = powerOfTen(newPrec - Digits);
          Data *= scale;
        }
       else
        {
-         scale = pow(Integer(10), Integer((long) (Digits - newPrec)));
+         scale = powerOfTen(Digits - newPrec);
          quotrem(Data, scale, Data, rem);
 
          rem *= Integer(2);
@@ -275,7 +316,7 @@ namespace BigInt
       if (Digits == 0) return result;
       if (result.length() <= Digits)
        {
-         while (result.length() < Digits) result = '0' + result;
+         result = std::string(Digits - result.length(), '0') + result;
          result = '0' + (SEPERATOR + result);
        }
       else
@@ -370,7 +411,7 @@ namespace BigInt
     {
       Integer temp, scale;
 
-      scale = pow(Integer(10), Integer((long) (Digits)));
+      scale = powerOfTen(Digits);
       quotrem(Data, scale, temp, scale);
 
       return scale.isZero();
@@ -380,7 +421,7 @@ namespace BigInt
     {
       Integer temp, scale;
 
-      scale = pow(Integer(10), Integer((long) (Digits)));
+      scale = powerOfTen(Digits);
       quotrem(Data, scale, temp, scale);
 
       return scale.isZero() ? temp.isOdd() : false;
@@ -390,7 +431,7 @@ namespace BigInt
     {
       Integer temp, scale;
 
-      scale = pow(Integer(10), Integer((long) (Digits)));
+      scale = powerOfTen(Digits);
       quotrem(Data, scale, temp, scale);
 
       return scale.isZero() ? temp.isEven() : false;
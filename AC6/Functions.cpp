@@ -17,6 +17,10 @@
    You should have received a copy of the GNU General Public License
    along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
 #include "Float.hpp"
 #include "Constants.hpp"
 
@@ -339,8 +343,12 @@ namespace BigInt
             temp *= one; //which is now ln(10)
             res += temp;
             break;
-         case 2:
-            temp = Float(Integer((long long) opp.Exponent).toString() + ".5");
+         case 2: //For y < 0, y + .5 is -(-y - 1).5
+            if (opp.Exponent < 0)
+               temp = Float("-" +
+                  Integer((long long) (-opp.Exponent - 1)).toString() + ".5");
+            else
+               temp = Float(Integer((long long) opp.Exponent).toString() + ".5");
             one = M_LN10;
 
             temp *= one;
@@ -425,44 +433,134 @@ namespace BigInt
    NOTES:
       Reduce for sine and cosine.
 
-      This doesn't produce accurate results for numbers with great magnitude.
-      One needs exponent extra digits of precision to get the correct
-      accuracy.
+      This is Payne and Hanek's reduction, in base ten. The argument is
+      M * 10 ^ k, for an integer M of precision + 1 digits, and what is
+      wanted is the fraction part of M * 10 ^ k / (2 * pi). The digits of
+      1 / (2 * pi) down to 10 ^ -k only ever add integers to that, and the
+      digits far enough past it don't reach the digits wanted. So the
+      fraction is a window of G digits of 1 / (2 * pi), starting at the
+      (k + 1)th, times M, mod 10 ^ G. Its cost depends on the precision, not
+      on how big the argument is.
+
+      The table of 1 / (2 * pi) isn't long enough for big arguments, so the
+      window is taken from a string of its digits, kept for each thread and
+      made longer when an argument needs more of them. They come from
+      Machin's formula, pi = 16 * atan(1 / 5) - 4 * atan(1 / 239), worked in
+      scaled Integers. That is the only cost that grows with the argument,
+      and it is paid once.
+
+      M and k are read from the argument's string, and the fraction is made
+      back into a Float the same way.
+
+      If the argument is close to a multiple of 2 * pi, the fraction has
+      leading zeros, and the window is made longer until there are enough
+      digits after them.
 ==============================================================================
 */
-   static void reduce (Float & arg)
+   static thread_local std::string recip2PiDigits;
+
+    /* scale * atan(1 / n), by its series, truncating every term */
+   static Integer atanRecip (long n, const Integer & scale)
     {
-      Fixed_Round_Mode temp;
+      Integer res, power (scale / Integer(n)), square (n * n);
+      bool alt = false;
 
-      temp = Fixed::getRoundMode();
-      Fixed::setRoundMode(ROUND_ZERO);
+      for (long k = 1; !power.isZero(); k += 2)
+       {
+         if (alt) res -= power / Integer(k);
+         else res += power / Integer(k);
+         alt = !alt;
 
-      Float twopi (arg), oneovertwopi (arg), res (arg);
-      unsigned long prec = res.getPrecision();
+         power /= square;
+       }
 
-      twopi = M_2PI;
-      oneovertwopi = M_1_2PI;
+      return res;
+    }
 
-      for (int loops = 0; (loops < 64) && (arg > twopi); loops++)
+    /*
+      The count digits of 1 / (2 * pi) after the first digits after the
+      decimal point.
+    */
+   static std::string recip2Pi (unsigned long first, unsigned long count)
+    {
+      if (recip2PiDigits.size() < first + count)
        {
-         res = arg * oneovertwopi;
-         res.changePrecision(res.exponent());
-         res.changePrecision(prec);
+         unsigned long length = 2 * recip2PiDigits.size();
+         if (length < first + count) length = first + count;
 
-         arg -= (res * twopi);
+          /*
+            The terms are truncated, so take some more digits than are
+            kept, and throw them away.
+          */
+         Integer scale (pow(Integer(10), Integer((long)(length + 10))));
+         Integer pi (Integer(4) * (Integer(4) * atanRecip(5, scale) -
+                                   atanRecip(239, scale)));
+
+         recip2PiDigits = (scale * scale / (Integer(2) * pi)).toString();
+         recip2PiDigits.resize(length);
        }
 
-      if (arg > twopi)
+      return recip2PiDigits.substr(first, count);
+    }
+
+   static void reduce (Float & arg)
+    {
+      unsigned long prec = arg.getPrecision();
+      Float twopi (arg), res (arg);
+
+      twopi = M_2PI;
+      if (!(arg > twopi)) return;
+
+      std::string digits (arg.toString()), mantissa;
+      std::string::size_type e = digits.find('E');
+      long k = std::atol(digits.c_str() + e + 1);
+
+      for (std::string::size_type i = 0; i < e; i++)
+       {
+         if ((digits[i] >= '0') && (digits[i] <= '9')) mantissa += digits[i];
+         else if (digits[i] == '.') k -= (long)(e - i - 1);
+       }
+
+      Integer M (mantissa), scale, high, low;
+      unsigned long G = 2 * prec + 12;
+
+      for (;;)
        {
-         arg *= oneovertwopi;
-         res = arg;
-         res.changePrecision(res.exponent());
-         res.changePrecision(prec);
-         arg -= res;
-         arg *= twopi;
+         std::string window;
+
+         if (k < 0) //The digits before the decimal point are all zero.
+          {
+            window.assign((unsigned long)-k, '0');
+            window += recip2Pi(0, G + k);
+          }
+         else
+            window = recip2Pi((unsigned long)k, G);
+
+         scale = pow(Integer(10), Integer((long)G));
+         divmod(M * Integer(window), scale, high, low);
+
+         if (low.isZero())
+          {
+            G += prec + 10;
+            continue;
+          }
+
+         std::ostringstream frac;
+         frac << low.toString() << "E-" << G;
+         res = Float(frac.str());
+
+          /*
+            The last prec + 2 digits of low may be wrong: are there enough
+            before them?
+          */
+         long good = (long)G + res.exponent() + 1 - (long)(prec + 2);
+         if (good < (long)prec + 1)
+            G += (unsigned long)((long)prec + 1 - good) + 10;
+         else
+            break;
        }
 
-      Fixed::setRoundMode(temp);
+      arg = res * twopi;
     }
 
 /*
@@ -79,6 +79,8 @@ namespace BigInt
             Data (), Digits (precision), sticky(false) { }
          Fixed (long i, unsigned long p = defPrec) :
             Data (i), Digits (p), sticky(false) { }
+         Fixed (const Integer & i, unsigned long p = defPrec) :
+            Data (i), Digits (p), sticky(false) { }
          Fixed (const std::string &);
          Fixed (const char *);
          ~Fixed () { /* This has nothing to do. */ }
@@ -65,6 +65,65 @@ namespace BigInt
     }
 
 
+   Float::Float (const Integer & mantissa, long exponent,
+                 unsigned long precision) :
+      Data (mantissa, 0), Sign (mantissa.isSigned()), Exponent (0),
+      Infinity (false), NaN (0)
+    {
+      Data.abs();
+      if (Data.isZero())
+       {
+         Data.setPrecision(precision);
+         return;
+       }
+
+         //A guess at the number of digits, less one, that normalize fixes.
+      long digits = (long)((double)mantissa.msb() * 0.30102999566398120);
+
+      if ((exponent + digits) > maxExponent)
+       {
+         Infinity = true;
+         Data = Fixed(0, minPrecision);
+         return;
+       }
+      if ((exponent + digits) < (minExponent - 1))
+       {
+         Data = Fixed(0, minPrecision);
+         return;
+       }
+
+      Data.setPrecision(digits);
+      Exponent = exponent + digits;
+      normalize();
+
+      if (Exponent < minExponent)
+       {
+         Exponent = 0;
+         Data = Fixed(0, minPrecision);
+       }
+      else if (!Infinity) setPrecision(precision);
+    }
+
+   Integer Float::toInteger (long exponent) const
+    {
+      if (!isUnSpecial()) return Integer();
+
+      Fixed temp (Data);
+      long digits = Exponent - exponent;
+
+      temp.setSign(Sign);
+      if (digits >= 0)
+       {
+         temp.changePrecision(digits);
+         temp.setPrecision(0);
+       }
+      else
+         temp.setPrecision(temp.getPrecision() - digits);
+
+      return temp.roundToInteger();
+    }
+
+
    void Float::precisionChanger(unsigned long newPrecision)
     {
       bool checkOverflow = newPrecision < Data.getPrecision();
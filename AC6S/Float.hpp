@@ -85,6 +85,16 @@ namespace BigInt
          Float (const char *);
          ~Float () { /* This has nothing to do. */ }
 
+          /*
+            For the functions that work with exact integers: the first makes
+            mantissa * 10 ^ exponent, rounded to precision digits, and
+            toInteger is the inverse, this * 10 ^ -exponent rounded to an
+            Integer.
+          */
+         Float (const Integer & mantissa, long exponent,
+                unsigned long precision);
+         Integer toInteger (long exponent) const;
+
          unsigned long getPrecision (void) const
           { return Data.getPrecision(); }
          unsigned long setPrecision (unsigned long newPrecision)
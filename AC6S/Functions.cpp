@@ -17,6 +17,8 @@
    You should have received a copy of the GNU General Public License
    along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
+#include <string>
+
 #include "Float.hpp"
 #include "Constants.hpp"
 
@@ -26,6 +28,8 @@ namespace BigInt
 
 	unsigned long SERIESEXTRA = 8;
 	unsigned long DERIVEDEXTRA = 4;
+	unsigned long SPLITPRECISION = 0;
+	unsigned long SPLITSTART = 8;
 
 /*
 ==============================================================================
@@ -81,6 +85,264 @@ namespace BigInt
       return curApprox;
     }
 
+/*
+==============================================================================
+   Function: binary splitting (source file scope only)
+------------------------------------------------------------------------------
+   NOTES:
+      Summed term by term, every term of a series costs a divide at full
+      precision. Binary splitting (Haible and Papanikolaou, "Fast
+      Multiprecision Evaluation of Series of Rational Numbers") sums it
+      exactly instead. For the terms
+         t(1) = p(1) / q(1),   t(n) = t(n - 1) * p(n) / q(n)
+      split finds, for the terms a to b - 1, the products P of the p's and
+      Q of the q's, and a T such that T / Q is their sum. The two halves of
+      a range are put together as
+         P = P1 * P2,   Q = Q1 * Q2,   T = T1 * Q2 + P1 * T2
+      and there is only one division, at the very end. When p and q are
+      small, this is quasi-linear in the cost of a multiplication.
+
+      An argument with many digits doesn't give a small p, so it is cut into
+      pieces (Brent's "bit-burst"): the first SPLITSTART significant digits,
+      then the next that many, then twice that, and so on. Each piece has
+      about as many leading zeros as it has digits, so the terms of its
+      series shrink as fast as their numbers grow. The pieces are put back
+      together with exp(a + b) = exp(a) * exp(b), the angle sum formulas,
+      and atan(x) = atan(a) + atan((x - a) / (1 + x * a)).
+
+      The term-by-term loops are still used below SPLITPRECISION digits.
+      Even with the small argument reductions done before them, splitting
+      was no slower at any precision tried (down to four digits), so the
+      threshold is zero unless it is changed.
+==============================================================================
+*/
+   enum Series { EXP_SERIES, SIN_SERIES, COS_SERIES, ATAN_SERIES };
+
+   struct Split
+    {
+      Integer P, Q, T;
+    };
+
+    /*
+      The ratio of term n to the one before it. For exp, x / scale is the
+      piece, and for the rest, it is the piece squared.
+    */
+   static void splitTerm (Split & term, Series kind, long n,
+                          const Integer & x, const Integer & scale)
+    {
+      switch (kind)
+       {
+         case EXP_SERIES: // x / n
+            term.P = x;
+            term.Q = scale * Integer(n);
+            break;
+         case SIN_SERIES: // -x^2 / (2n * (2n + 1))
+            term.P = -x;
+            term.Q = scale * Integer(2 * n * (2 * n + 1));
+            break;
+         case COS_SERIES: // -x^2 / ((2n - 1) * 2n)
+            term.P = -x;
+            term.Q = scale * Integer((2 * n - 1) * 2 * n);
+            break;
+         case ATAN_SERIES: // -x^2 * (2n - 1) / (2n + 1)
+            term.P = x * Integer(1 - 2 * n);
+            term.Q = scale * Integer(2 * n + 1);
+            break;
+       }
+      term.T = term.P;
+    }
+
+    /* P is only needed for the left half of a range. */
+   static void split (Split & res, Series kind, long a, long b,
+                      const Integer & x, const Integer & scale, bool needP)
+    {
+      if (b - a == 1)
+       {
+         splitTerm(res, kind, a, x, scale);
+         return;
+       }
+
+      Split right;
+      long mid = (a + b) / 2;
+
+      split(res, kind, a, mid, x, scale, true);
+      split(right, kind, mid, b, x, scale, needP);
+
+      res.T = res.T * right.Q + res.P * right.T;
+      res.Q *= right.Q;
+      if (needP) res.P *= right.P;
+    }
+
+    /*
+      The number of terms needed for digits digits, for a piece less
+      than 10 ^ lead.
+    */
+   static long splitTerms (Series kind, long lead, unsigned long digits)
+    {
+      double scale = 1.0; // The term is about scale * 10 ^ size.
+      long size = 0, n = 0;
+
+      while (size >= -(long)digits)
+       {
+         n++;
+         switch (kind)
+          {
+            case EXP_SERIES:
+               size += lead;
+               scale /= (double)n;
+               break;
+            case SIN_SERIES:
+               size += 2 * lead;
+               scale /= (double)(2 * n * (2 * n + 1));
+               break;
+            case COS_SERIES:
+               size += 2 * lead;
+               scale /= (double)((2 * n - 1) * 2 * n);
+               break;
+            case ATAN_SERIES:
+               size += 2 * lead;
+               break;
+          }
+         while (scale < 0.1)
+          {
+            scale *= 10.0;
+            size--;
+          }
+       }
+
+      return n;
+    }
+
+    /*
+      The series for the piece x / 10 ^ digits, which is less than
+      10 ^ lead, to precision digits. This is 1 + T / Q. For sin and atan,
+      that is still to be multiplied by the piece.
+    */
+   static Float splitSum (Series kind, const Integer & x, unsigned long digits,
+                          long lead, unsigned long precision)
+    {
+      Integer num (x), scale (pow(Integer(10), Integer((long)digits)));
+      Split sum;
+
+      if (kind != EXP_SERIES)
+       {
+         num *= num;
+         scale *= scale;
+       }
+
+      split(sum, kind, 1, splitTerms(kind, lead, precision) + 1, num, scale,
+            false);
+
+      return Float(sum.T + sum.Q, 0, precision) /
+             Float(sum.Q, 0, precision);
+    }
+
+    /*
+      Takes the next piece off of the front of rest, which has precision
+      digits after the decimal point. The piece is the digits up to the
+      to'th, and the next one will be twice as long.
+    */
+   static void nextPiece (Integer & rest, Integer & piece,
+                          unsigned long & to, unsigned long precision)
+    {
+      if (to > precision) to = precision;
+      divmod(rest, pow(Integer(10), Integer((long)(precision - to))),
+             piece, rest);
+    }
+
+    /* The first piece, of SPLITSTART significant digits of x. */
+   static unsigned long firstPiece (const Float & x)
+    {
+      return ((x.exponent() < 0) ? -x.exponent() - 1 : 0) + SPLITSTART;
+    }
+
+    /* exp(x) for 0 <= x < 1. */
+   static Float expSplit (const Float & x, unsigned long precision)
+    {
+      Integer rest (x.toInteger(-(long)precision)), piece;
+      Float res (Integer(1), 0, precision);
+      long lead = x.exponent() + 1;
+
+      for (unsigned long to = firstPiece(x); !rest.isZero(); to *= 2)
+       {
+         nextPiece(rest, piece, to, precision);
+         if (!piece.isZero())
+            res *= splitSum(EXP_SERIES, piece, to, lead, precision);
+         lead = -(long)to;
+       }
+
+      return res;
+    }
+
+    /* sin(x) and cos(x) for 0 <= x < 10. */
+   static void sinCosSplit (const Float & x, unsigned long precision,
+                            Float & s, Float & c)
+    {
+      Integer rest (x.toInteger(-(long)precision)), piece;
+      long lead = x.exponent() + 1;
+
+      s = Float(Integer(), 0, precision);
+      c = Float(Integer(1), 0, precision);
+
+      for (unsigned long to = firstPiece(x); !rest.isZero(); to *= 2)
+       {
+         nextPiece(rest, piece, to, precision);
+         if (!piece.isZero())
+          {
+            Float pieceSin (piece, -(long)to, precision), pieceCos;
+
+            pieceSin *= splitSum(SIN_SERIES, piece, to, lead, precision);
+            pieceCos = splitSum(COS_SERIES, piece, to, lead, precision);
+
+            Float temp (s * pieceCos + c * pieceSin);
+            c = c * pieceCos - s * pieceSin;
+            s = temp;
+          }
+         lead = -(long)to;
+       }
+    }
+
+    /*
+      atan(x) for 0 < x < 1. It is first brought under 0.1 with
+         atan(x) = 2 * atan(x / (1 + sqrt(1 + x * x)))
+      so that the first series converges quickly.
+    */
+   static Float atanSplit (const Float & x, unsigned long precision)
+    {
+      Float one (Integer(1), 0, precision), y (x);
+      Float res (Integer(), 0, precision);
+      int halvings = 0;
+
+      y.setPrecision(precision);
+      while (y.exponent() >= -1)
+       {
+         y = y / (one + sqrt(one + (y * y)));
+         halvings++;
+       }
+
+      long lead = y.exponent() + 1;
+      for (unsigned long to = firstPiece(y); !y.isZero(); to *= 2)
+       {
+         if (to > precision) to = precision;
+
+         Integer piece (y.toInteger(-(long)to));
+         if (!piece.isZero())
+          {
+            Float pieceFloat (piece, -(long)to, precision);
+
+            res += pieceFloat * splitSum(ATAN_SERIES, piece, to, lead,
+                                         precision);
+            y = (y - pieceFloat) / (one + y * pieceFloat);
+          }
+         if (to == precision) break;
+         lead = -(long)to;
+       }
+
+      while (halvings--) res += res;
+
+      return res;
+    }
+
 /*
 ==============================================================================
    Function: exponential function, Euler's constant to a real power
@@ -162,17 +424,22 @@ namespace BigInt
        }
 
 
-      res += currentPower;
-      currentPower *= copyOpp;
-
-      temp = currentPower / currentDivisor;
-      while (change(temp, res))
+      if (one.getPrecision() >= SPLITPRECISION)
+         res = expSplit(copyOpp, one.getPrecision());
+      else
        {
-         res += temp;
-         currentFactorial += one;
-         currentDivisor *= currentFactorial;
+         res += currentPower;
          currentPower *= copyOpp;
+
          temp = currentPower / currentDivisor;
+         while (change(temp, res))
+          {
+            res += temp;
+            currentFactorial += one;
+            currentDivisor *= currentFactorial;
+            currentPower *= copyOpp;
+            temp = currentPower / currentDivisor;
+          }
        }
 
       if (special)
@@ -317,8 +584,12 @@ namespace BigInt
             temp *= one; //which is now ln(10)
             res += temp;
             break;
-         case 2:
-            temp |= Float(Integer(opp.Exponent).toString() + ".5");
+         case 2: //For y < 0, y + .5 is -(-y - 1).5
+            if (opp.Exponent < 0)
+               temp |= Float("-" +
+                  Integer((-opp.Exponent - 1)).toString() + ".5");
+            else
+               temp |= Float(Integer(opp.Exponent).toString() + ".5");
             one |= M_LN10;
 
             temp *= one;
@@ -401,47 +672,117 @@ namespace BigInt
    NOTES:
       Reduce for sine and cosine.
 
-      This doesn't produce accurate results for numbers with great magnitude.
-      One needs exponent extra digits of precision to get the correct
-      accuracy.
+      This is Payne and Hanek's reduction, in base ten. The argument is
+      M * 10 ^ k, for an integer M of precision + 1 digits, and what is
+      wanted is the fraction part of M * 10 ^ k / (2 * pi). The digits of
+      1 / (2 * pi) down to 10 ^ -k only ever add integers to that, and the
+      digits far enough past it don't reach the digits wanted. So the
+      fraction is a window of G digits of 1 / (2 * pi), starting at the
+      (k + 1)th, times M, mod 10 ^ G. Its cost depends on the precision, not
+      on how big the argument is.
+
+      The table of 1 / (2 * pi) isn't long enough for big arguments, so the
+      window is taken from a string of its digits, kept for each thread and
+      made longer when an argument needs more of them. They come from
+      Machin's formula, pi = 16 * atan(1 / 5) - 4 * atan(1 / 239), worked in
+      scaled Integers. That is the only cost that grows with the argument,
+      and it is paid once.
+
+      If the argument is close to a multiple of 2 * pi, the fraction has
+      leading zeros, and the window is made longer until there are enough
+      digits after them.
 ==============================================================================
 */
-   static void reduce (Float & arg)
+   static thread_local std::string recip2PiDigits;
+
+    /* scale * atan(1 / n), by its series, truncating every term */
+   static Integer atanRecip (long n, const Integer & scale)
     {
-      Fixed_Round_Mode temp;
+      Integer res, power (scale / Integer(n)), square (n * n);
+      bool alt = false;
 
-      temp = Fixed::getRoundMode();
-      Fixed::setRoundMode(ROUND_ZERO);
+      for (long k = 1; !power.isZero(); k += 2)
+       {
+         if (alt) res -= power / Integer(k);
+         else res += power / Integer(k);
+         alt = !alt;
 
-      Float twopi (arg), oneovertwopi (arg), res (arg), tempf (arg);
-      unsigned long prec = res.getPrecision();
+         power /= square;
+       }
 
-      twopi |= M_2PI;
-      oneovertwopi |= M_1_2PI;
-      tempf.setPrecision(tempf.getPrecision() * 2);
+      return res;
+    }
 
-      for (int loops = 0; (loops < 64) && (arg > twopi); loops++)
+    /*
+      The count digits of 1 / (2 * pi) after the first digits after the
+      decimal point.
+    */
+   static std::string recip2Pi (unsigned long first, unsigned long count)
+    {
+      if (recip2PiDigits.size() < first + count)
        {
-         res = arg * oneovertwopi;
-         res.setPrecision(res.exponent());
-         res.setPrecision(prec);
-
-         tempf |= res;
-         tempf = arg - (tempf * twopi);
-         arg |= tempf;
+         unsigned long length = 2 * recip2PiDigits.size();
+         if (length < first + count) length = first + count;
+
+          /*
+            The terms are truncated, so take some more digits than are
+            kept, and throw them away.
+          */
+         Integer scale (pow(Integer(10), Integer((long)(length + 10))));
+         Integer pi (Integer(4) * (Integer(4) * atanRecip(5, scale) -
+                                   atanRecip(239, scale)));
+
+         recip2PiDigits = (scale * scale / (Integer(2) * pi)).toString();
+         recip2PiDigits.resize(length);
        }
 
-      if (arg > twopi)
+      return recip2PiDigits.substr(first, count);
+    }
+
+   static void reduce (Float & arg)
+    {
+      unsigned long prec = arg.getPrecision();
+      Float twopi (arg);
+
+      twopi |= M_2PI;
+      if (!(arg > twopi)) return;
+
+      long k = arg.exponent() - (long)prec;
+      Integer M (arg.toInteger(k)), scale, high, low;
+      unsigned long G = 2 * prec + 12;
+      Float res;
+
+      for (;;)
        {
-         arg *= oneovertwopi;
-         res = arg;
-         res.setPrecision(res.exponent());
-         res.setPrecision(prec);
-         arg -= res;
-         arg *= twopi;
+         std::string window;
+
+         if (k < 0) //The digits before the decimal point are all zero.
+          {
+            window.assign((unsigned long)-k, '0');
+            window += recip2Pi(0, G + k);
+          }
+         else
+            window = recip2Pi((unsigned long)k, G);
+
+         scale = pow(Integer(10), Integer((long)G));
+         divmod(M * Integer(window), scale, high, low);
+
+         res = Float(low, -(long)G, prec);
+
+          /*
+            The last prec + 2 digits of low may be wrong: are there enough
+            before them?
+          */
+         long good = (long)G + res.exponent() + 1 - (long)(prec + 2);
+         if (res.isZero())
+            G += prec + 10;
+         else if (good < (long)prec + 1)
+            G += (unsigned long)((long)prec + 1 - good) + 10;
+         else
+            break;
        }
 
-      Fixed::setRoundMode(temp);
+      arg = res * twopi;
     }
 
 /*
@@ -473,6 +814,19 @@ namespace BigInt
       copyOpp |= opp;
       reduce(copyOpp.abs()); //We will replace the sign later.
 
+      if (one.getPrecision() >= SPLITPRECISION)
+       {
+         Float res, unused;
+         unsigned long digits = one.getPrecision();
+
+         if (copyOpp.exponent() < 0) digits -= copyOpp.exponent();
+         sinCosSplit(copyOpp, digits, res, unused);
+
+         if (opp.isSigned()) res.negate();
+         res.setPrecision(opp.getPrecision());
+         return res;
+       }
+
       Float currentPower (copyOpp);
       Float res (copyOpp);
 
@@ -532,6 +886,16 @@ namespace BigInt
       copyOpp |= opp; //We don't need to replace the sign as
       reduce(copyOpp.abs()); //cos is symmetric about 0.
 
+      if (one.getPrecision() >= SPLITPRECISION)
+       {
+         Float res, unused;
+
+         sinCosSplit(copyOpp, one.getPrecision(), unused, res);
+
+         res.setPrecision(opp.getPrecision());
+         return res;
+       }
+
       Float currentPower (copyOpp);
       Float res (one);
 
@@ -625,6 +989,27 @@ namespace BigInt
       copyOpp.abs(); //Sign will be restored later.
       int Series = copyOpp.compare(one);
 
+      if ((Series != 0) && (one.getPrecision() >= SPLITPRECISION))
+       {
+         Float res (one);
+         unsigned long digits = one.getPrecision();
+
+         if (Series > 0)
+          {
+            res |= M_PI_2;
+            res -= atanSplit(one / copyOpp, digits);
+          }
+         else
+          {
+            if (copyOpp.exponent() < 0) digits -= copyOpp.exponent();
+            res = atanSplit(copyOpp, digits);
+          }
+
+         if (opp.isSigned()) res.negate();
+         res.setPrecision(opp.getPrecision());
+         return res;
+       }
+
       Float res (copyOpp);
       Float currentPower (copyOpp);
       copyOpp *= copyOpp;
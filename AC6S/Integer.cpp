@@ -161,6 +161,12 @@ namespace BigInt
       return Sign ? -mpz_get_si(Data->Data) : mpz_get_si(Data->Data);
     }
 
+   long Integer::msb (void) const
+    {
+      if (isZero()) return -1;
+      return (long)mpz_sizeinbase(Data->Data, 2) - 1;
+    }
+
 
 
    Integer & Integer::negate (void)
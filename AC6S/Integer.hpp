@@ -90,6 +90,7 @@ namespace BigInt
          bool operator ! (void) const { return isZero(); }
 
          long toInt (void) const; //Not perfect, but not terrible.
+         long msb (void) const;
 
          int compare (const Integer &) const;
 
@@ -29,6 +29,7 @@ SUCH DAMAGE.
 
 #include "BitField.hpp"
 #include <cstring>
+#include <mutex>
 
 namespace BigInt
  {
@@ -42,12 +43,12 @@ namespace BigInt
 
       BitField::bits is the number of bits in our "Unit". It can be decreased
       so that an unsigned type isn't needed. Decreasing it can also allow you
-      to remove the upcast in += and -=.
+      to remove the upcast in addStep and subStep.
 
       If you are using less bits than your word size, uncomment the commented
       portion of mask. The comments are just to force the compiler to shut up.
 
-      NEXT_TYPE is the type used for upcasting. /= uses "unsigned NEXT_TYPE",
+      NEXT_TYPE is the type used for upcasting. It is mostly "unsigned NEXT_TYPE",
       so I don't know if it can be a typedef. NEXT_TYPE should be a type that
       has at least BitField::bits * 2 bits in it.
 
@@ -73,16 +74,231 @@ namespace BigInt
 #endif /* BIG_INT_QUAD_BYTE */
 
 
+    /*
+      The pool. Holders and Unit arrays are made and thrown away constantly,
+      so rather than give them back to the heap, freed ones are kept on free
+      lists. Arrays are rounded up to a size class: class c holds arrays of
+      MinPoolUnits << c Units. Arrays too big for the last class come from
+      and go to the heap. Holders have a list of their own.
+
+      Each thread has its own lists, so most of the time no lock is taken.
+      When one of a thread's lists holds more than PoolCacheBytes, half of
+      it goes to the global lists, and a thread with an empty list takes a
+      batch from them before it goes to the heap. A thread's lists are given
+      to the global lists when it exits.
+
+      A hit is a block that came off of a list, and a miss is one that came
+      from the heap.
+    */
+   const static long MinPoolUnits = 8;
+   const static int PoolClasses = 12;
+   const static int HolderList = PoolClasses;
+   const static int PoolLists = PoolClasses + 1;
+   const static long PoolCacheBytes = 256 * 1024;
+   const static long HolderPoolLimit = 4096;
+   const static long GlobalPoolCaches = 8;
+
+   struct PoolBlock
+    {
+      PoolBlock * Next;
+    };
+
+   struct Pool
+    {
+      PoolBlock * Head [PoolLists];
+      long Count [PoolLists];
+      unsigned long Hits, Misses;
+      bool Started, Finished;
+    };
+
+    /* These are all zero-initialized: there's no order of construction. */
+   static thread_local Pool localPool;
+   static Pool globalPool;
+   static std::mutex globalLock;
+
+   class PoolFlusher
+    {
+      public:
+         ~PoolFlusher ();
+    };
+
+    /* How many blocks of this list a thread keeps for itself. */
+   static long poolLimit (int list)
+    {
+      if (list == HolderList) return HolderPoolLimit;
+
+      long limit = (PoolCacheBytes / (MinPoolUnits * (long) sizeof(Unit))) >> list;
+      return (limit < 4) ? 4 : limit;
+    }
+
+    /* Move count blocks from the front of from's list to to's. */
+   static void poolMove (Pool & from, Pool & to, int list, long count)
+    {
+      PoolBlock * block;
+
+      from.Count[list] -= count;
+      to.Count[list] += count;
+      for (; count > 0; count--)
+       {
+         block = from.Head[list];
+         from.Head[list] = block->Next;
+         block->Next = to.Head[list];
+         to.Head[list] = block;
+       }
+    }
+
+    /* The first time a thread uses the pool, arrange to flush it at exit. */
+   static void poolStart (void)
+    {
+      static thread_local PoolFlusher flusher;
+      (void) flusher;
+
+      localPool.Started = true;
+    }
+
+   PoolFlusher::~PoolFlusher ()
+    {
+      std::lock_guard<std::mutex> lock (globalLock);
+
+      for (int list = 0; list < PoolLists; list++)
+         poolMove(localPool, globalPool, list, localPool.Count[list]);
+
+      globalPool.Hits += localPool.Hits;
+      globalPool.Misses += localPool.Misses;
+      localPool.Hits = 0;
+      localPool.Misses = 0;
+
+       /*
+         Numbers that outlive the pool, like other thread_locals and
+         globals, go back to the heap from here on.
+       */
+      localPool.Finished = true;
+    }
+
+   static void * poolTake (int list, std::size_t bytes)
+    {
+      Pool & local = localPool;
+      PoolBlock * block = local.Head[list];
+
+      if ((block == NULL) && !local.Finished)
+       {
+         if (!local.Started) poolStart();
+
+         std::lock_guard<std::mutex> lock (globalLock);
+         long count = poolLimit(list) / 2;
+         if (count > globalPool.Count[list]) count = globalPool.Count[list];
+         poolMove(globalPool, local, list, count);
+
+         block = local.Head[list];
+       }
+
+      if (block == NULL)
+       {
+         local.Misses++;
+         return ::operator new (bytes);
+       }
+
+      local.Head[list] = block->Next;
+      local.Count[list]--;
+      local.Hits++;
+      return block;
+    }
+
+   static void poolGive (int list, void * p)
+    {
+      Pool & local = localPool;
+      PoolBlock * block = static_cast<PoolBlock *>(p);
+
+      if (local.Finished)
+       {
+         ::operator delete (p);
+         return;
+       }
+      if (!local.Started) poolStart();
+
+      block->Next = local.Head[list];
+      local.Head[list] = block;
+      local.Count[list]++;
+
+      long limit = poolLimit(list);
+      if (local.Count[list] > limit)
+       {
+         std::lock_guard<std::mutex> lock (globalLock);
+         poolMove(local, globalPool, list, local.Count[list] / 2);
+
+          /* Don't hoard memory that no one is using. */
+         while (globalPool.Count[list] > GlobalPoolCaches * limit)
+          {
+            block = globalPool.Head[list];
+            globalPool.Head[list] = block->Next;
+            globalPool.Count[list]--;
+            ::operator delete (block);
+          }
+       }
+    }
+
+   static int unitClass (long units)
+    {
+      int c = 0;
+      while ((c < PoolClasses) && ((MinPoolUnits << c) < units)) c++;
+      return c;
+    }
+
+    /* Get an array of at least size Units. size becomes its actual size. */
+   static Unit * newUnits (long & size)
+    {
+      int c = unitClass(size);
+
+      if (c == PoolClasses)
+       {
+         localPool.Misses++;
+         return new Unit [size];
+       }
+
+      size = MinPoolUnits << c;
+      return static_cast<Unit *>(poolTake(c, size * sizeof(Unit)));
+    }
+
+   static void deleteUnits (Unit * data, long size)
+    {
+      int c = unitClass(size);
+
+      if (c == PoolClasses) delete [] data;
+      else poolGive(c, data);
+    }
+
+   void * BitField::BitHolder::operator new (std::size_t bytes)
+    {
+      return poolTake(HolderList, bytes);
+    }
+
+   void BitField::BitHolder::operator delete (void * holder)
+    {
+      poolGive(HolderList, holder);
+    }
+
+   void BitField::poolStatistics (unsigned long & hits, unsigned long & misses)
+    {
+      std::lock_guard<std::mutex> lock (globalLock);
+
+      hits = globalPool.Hits + localPool.Hits;
+      misses = globalPool.Misses + localPool.Misses;
+    }
+
+
 
    BitField::BitHolder::BitHolder () :
       Data (NULL), Length (0), Size (0), Refs(0) { }
 
+   BitField::BitHolder::BitHolder (Unit * src, long size) :
+      Data (src), Length (0), Size (size), Refs (1) { }
+
    BitField::BitHolder::BitHolder (const BitHolder & src, long extra) :
       Data (NULL), Length (0), Size (0), Refs (1)
     {
-         Data = new Unit [src.Length + extra];
-         Length = src.Length;
          Size = src.Length + extra;
+         Data = newUnits(Size);
+         Length = src.Length;
 
          std::memcpy(Data, src.Data, Length * sizeof(Unit));
     }
@@ -93,7 +309,7 @@ namespace BigInt
          Alot of finalization is added before deallocation in case we need
          to hunt down bugs.
        */
-      if (Data != NULL) delete [] Data;
+      if (Data != NULL) deleteUnits(Data, Size);
 
       Data = NULL;
       Length = 0;
@@ -103,483 +319,1702 @@ namespace BigInt
 
 
 
-   BitField::BitField () : Data (NULL), Zero (true) { }
+   BitField::BitField () :
+      Data (NULL), Zero (true), Local (Inline, InlineUnits) { }
 
-   BitField::BitField (Unit src) : Data (NULL), Zero (true)
+   BitField::BitField (Unit src) :
+      Data (NULL), Zero (true), Local (Inline, InlineUnits)
     {
       if (src != 0)
        {
-         Zero = false;
+         allocate(1);
+         Data->Data[0] = src;
+       }
+    }
+
+   BitField::BitField (const BitField & src) :
+      Data (NULL), Zero (true), Local (Inline, InlineUnits)
+    {
+      share(src);
+    }
+
+   BitField::BitField (BitField && src) :
+      Data (NULL), Zero (true), Local (Inline, InlineUnits)
+    {
+      take(src);
+    }
+
+
+
+   BitField::~BitField ()
+    {
+      release();
+
+       /* Inline isn't Local's to delete. */
+      Local.Data = NULL;
+    }
+
+
+
+    /*
+      Make a new number of length Units, which the caller will fill in.
+      We must be Zero.
+    */
+   void BitField::allocate (long length)
+    {
+      if (length <= InlineUnits)
+       {
+         Data = &Local;
+       }
+      else
+       {
          Data = new BitHolder;
 
-         Data->Data = new Unit [1];
-         Data->Length = 1;
-         Data->Size = 1;
+         long size = length;
+         Data->Data = newUnits(size);
+         Data->Size = size;
          Data->Refs = 1;
+       }
 
-         Data->Data[0] = src;
+      Data->Length = length;
+      Zero = false;
+    }
+
+    /* Let go of our Data and become Zero. */
+   void BitField::release (void)
+    {
+      if (Zero) return;
+
+      if (Data != &Local)
+       {
+         Data->Refs--;
+         if (Data->Refs == 0) delete Data;
        }
+
+      Data = NULL;
+      Zero = true;
     }
 
-   BitField::BitField (const BitField & src) :
-       Data (NULL), Zero (src.Zero)
+    /*
+      Become a copy of src. We must be Zero. Heap Data is shared, but Local
+      is copied.
+    */
+   void BitField::share (const BitField & src)
     {
-      if (!src.isZero())
+      if (src.isZero()) return;
+
+      if (src.Data == &src.Local)
+       {
+         Data = &Local;
+         Local.Length = src.Local.Length;
+         std::memcpy(Inline, src.Inline, Local.Length * sizeof(Unit));
+       }
+      else
        {
          Data = src.Data;
-         src.Data->Refs++;
+         Data->Refs++;
        }
+
+      Zero = false;
     }
 
+    /*
+      Become src, which becomes Zero. We must be Zero. Heap Data changes
+      hands without touching its reference count.
+    */
+   void BitField::take (BitField & src)
+    {
+      if (src.isZero()) return;
 
+      if (src.Data == &src.Local)
+       {
+         Data = &Local;
+         Local.Length = src.Local.Length;
+         std::memcpy(Inline, src.Inline, Local.Length * sizeof(Unit));
+       }
+      else
+       {
+         Data = src.Data;
+       }
 
-   BitField::~BitField ()
+      Zero = false;
+      src.Data = NULL;
+      src.Zero = true;
+    }
+
+    /*
+      As BitField is composed of only mutator methods, one of the first
+      things we do is make sure we "own" the Data that we are mutating.
+      If we need to copy it, we leave room for extra more Units.
+    */
+   void BitField::own (long extra)
     {
-      if (!Zero)
+      if (Data->Refs == 1) return;
+
+      BitHolder * old = Data;
+
+      if (old->Length + extra <= InlineUnits)
        {
-         Data->Refs--;
-         if (Data->Refs == 0) delete Data;
+         Data = &Local;
+         Local.Length = old->Length;
+         std::memcpy(Inline, old->Data, Local.Length * sizeof(Unit));
+       }
+      else
+       {
+         Data = new BitHolder (*old, extra);
+       }
+
+      old->Refs--; // It was shared, so someone else still has it.
+    }
+
+    /* Make room for size Units. We must own our Data. */
+   void BitField::reserve (long size)
+    {
+      if (size <= Data->Size) return;
+
+      Unit * newData = newUnits(size);
 
-         Data = NULL;
-         Zero = true;
+      std::memcpy(newData, Data->Data, Data->Length * sizeof(Unit));
+
+      if (Data == &Local)
+       {
+         Data = new BitHolder;
+         Data->Length = Local.Length;
+         Data->Refs = 1;
+       }
+      else
+       {
+         deleteUnits(Data->Data, Data->Size);
        }
+
+      Data->Data = newData;
+      Data->Size = size;
     }
 
 
 
     /*
-      Note that neither this nor >>= support negative amounts.
+      The Unit array kernels, which everything else is built on.
+
+      Each one is a loop over a carry chain, so the carry is kept in the form
+      that the compiler turns into add-with-carry: __builtin_addcll and
+      __builtin_subcll where the compiler has them, and a double-width sum
+      otherwise. On x86-64 the multiply-accumulate rows use MULX and the two
+      carry chains of ADCX and ADOX when the processor has them, which is
+      checked once, the first time a row is multiplied. Division by a Unit
+      multiplies by a precomputed reciprocal instead of dividing (Moller and
+      Granlund, "Improved division by invariant integers", 2011).
+
+      Defining BIG_INT_PORTABLE leaves only plain C++, with the carries found
+      by comparison.
     */
-   void BitField::operator <<= (long amount)
+#if !defined(BIG_INT_QUAD_BYTE) && !defined(BIG_INT_PORTABLE)
+ #if defined(__has_builtin)
+  #if __has_builtin(__builtin_addcll) && __has_builtin(__builtin_subcll)
+   #define BIG_INT_ADDC
+  #endif
+ #endif
+#endif
+
+    /* Returns a + b + carry, and sets carry to the carry out. */
+   static inline Unit addStep (Unit a, Unit b, Unit & carry)
     {
-      long addedUnits = amount / bits;
-      int shiftAmount = amount % bits;
-      int rightShift = bits - shiftAmount;
-      long newLength;
-      Unit carry = 0, oldCarry, * newData = NULL;
+#if defined(BIG_INT_ADDC)
+      unsigned long long out;
+      Unit sum = __builtin_addcll(a, b, carry, &out);
+      carry = (Unit)out;
+      return sum;
+#elif defined(BIG_INT_PORTABLE)
+      a += carry;
+      carry = (a < carry) ? 1 : 0;
+      b += a;
+      carry += (b < a) ? 1 : 0;
+      return b;
+#else
+      unsigned NEXT_TYPE temp = (unsigned NEXT_TYPE)a + b + carry;
+      carry = (Unit)(temp >> BitField::bits);
+      return (Unit)temp;
+#endif
+    }
 
-       /* Are we essentially doing nothing? */
-      if (Zero || (amount == 0)) return;
+    /* Returns a - b - borrow, and sets borrow to the borrow out. */
+   static inline Unit subStep (Unit a, Unit b, Unit & borrow)
+    {
+#if defined(BIG_INT_ADDC)
+      unsigned long long out;
+      Unit diff = __builtin_subcll(a, b, borrow, &out);
+      borrow = (Unit)out;
+      return diff;
+#elif defined(BIG_INT_PORTABLE)
+      b += borrow;
+      borrow = (b < borrow) ? 1 : 0;
+      borrow += (a < b) ? 1 : 0;
+      return a - b;
+#else
+      unsigned NEXT_TYPE temp = (unsigned NEXT_TYPE)a - b - borrow;
+      borrow = (Unit)(temp >> BitField::bits) & 1;
+      return (Unit)temp;
+#endif
+    }
 
-       /*
-         As BitField is composed of only mutator methods, one of the first
-         things we do is make sure we "own" the Data that we are mutating.
-       */
-      if (Data->Refs != 1)
+    /* r = a + b, where an >= bn. r has an Units. Returns the carry out. */
+   static Unit addUnits (Unit * r, const Unit * a, long an,
+                         const Unit * b, long bn)
+    {
+      Unit carry = 0;
+      long i;
+
+      for (i = 0; i < bn; i++)
+         r[i] = addStep(a[i], b[i], carry);
+      for (; i < an; i++)
+         r[i] = addStep(a[i], 0, carry);
+
+      return carry;
+    }
+
+    /*
+      r += a, where rn >= an, with the carry propagated through r.
+      Returns the carry out of r.
+    */
+   static Unit addInto (Unit * r, long rn, const Unit * a, long an)
+    {
+      Unit carry = 0;
+      long i;
+
+      for (i = 0; i < an; i++)
+         r[i] = addStep(r[i], a[i], carry);
+      for (; (i < rn) && (carry != 0); i++)
        {
-         Data->Refs--;
-         Data = new BitHolder (*Data, addedUnits + 1);
+         r[i]++;
+         carry = (r[i] == 0) ? 1 : 0;
        }
 
-       /*
-         Shift the data. We do the remainder mod bits here, as the quotient
-         is just the number of Units we need to add to the number.
-       */
-      if (shiftAmount != 0)
+      return carry;
+    }
+
+    /*
+      r -= a, where rn >= an, with the borrow propagated through r.
+      Returns the borrow out of r.
+    */
+   static Unit subFrom (Unit * r, long rn, const Unit * a, long an)
+    {
+      Unit borrow = 0;
+      long i;
+
+      for (i = 0; i < an; i++)
+         r[i] = subStep(r[i], a[i], borrow);
+      for (; (i < rn) && (borrow != 0); i++)
        {
-         for (long i = 0; i < Data->Length; i++)
-          {
-            oldCarry = carry;
-            carry = Data->Data[i] >> rightShift;
-            Data->Data[i] = (Data->Data[i] << shiftAmount) | oldCarry;
-          }
+         borrow = (r[i] == 0) ? 1 : 0;
+         r[i]--;
+       }
+
+      return borrow;
+    }
+
+    /* r = a * m, returns the carry out. r may be a. */
+   static Unit mulUnit (Unit * r, const Unit * a, long n, Unit m)
+    {
+      unsigned NEXT_TYPE temp;
+      Unit carry = 0;
+
+      for (long i = 0; i < n; i++)
+       {
+         temp = (unsigned NEXT_TYPE)a[i] * m + carry;
+         r[i] = (Unit)temp;
+         carry = (Unit)(temp >> BitField::bits);
+       }
+
+      return carry;
+    }
+
+    /* r += a * m, returns the carry out. */
+   static Unit addMulUnitLoop (Unit * r, const Unit * a, long n, Unit m)
+    {
+      unsigned NEXT_TYPE temp;
+      Unit carry = 0;
+
+      for (long i = 0; i < n; i++)
+       {
+         temp = (unsigned NEXT_TYPE)a[i] * m + r[i] + carry;
+         r[i] = (Unit)temp;
+         carry = (Unit)(temp >> BitField::bits);
+       }
+
+      return carry;
+    }
+
+#if !defined(BIG_INT_QUAD_BYTE) && !defined(BIG_INT_PORTABLE) && \
+   defined(__x86_64__) && defined(__GNUC__)
+    /*
+      The same, with MULX. The low half of each product is added to the high
+      half of the one before it on the ADCX chain (CF), and that is added to
+      r on the ADOX chain (OF). Neither chain waits on the other. Only LEA
+      and JRCXZ run the loop, as they leave the flags alone. n > 0.
+    */
+   static Unit addMulUnitMulx (Unit * r, const Unit * a, long n, Unit m)
+    {
+      Unit high = 0, low, next;
+      long i = -n;
+
+      __asm__ (
+         "xorl %k[low], %k[low]\n"
+         "1:\n\t"
+         "movq (%[a],%[i],8), %%rdx\n\t"
+         "mulxq %[m], %[low], %[next]\n\t"
+         "adcxq %[high], %[low]\n\t"
+         "adoxq (%[r],%[i],8), %[low]\n\t"
+         "movq %[low], (%[r],%[i],8)\n\t"
+         "movq %[next], %[high]\n\t"
+         "leaq 1(%[i]), %[i]\n\t"
+         "jrcxz 2f\n\t"
+         "jmp 1b\n"
+         "2:\n\t"
+         "movl $0, %k[low]\n\t"
+         "adcxq %[low], %[high]\n\t"
+         "adoxq %[low], %[high]\n"
+         : [high] "+&r" (high), [low] "=&r" (low), [next] "=&r" (next),
+           [i] "+&c" (i)
+         : [a] "r" (a + n), [r] "r" (r + n), [m] "r" (m)
+         : "rdx", "cc", "memory");
+
+      return high;
+    }
+
+   static bool haveMulx (void)
+    {
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("bmi2") && __builtin_cpu_supports("adx");
+    }
+
+   static Unit addMulUnit (Unit * r, const Unit * a, long n, Unit m)
+    {
+      static const bool mulx = haveMulx();
+      if (mulx && (n > 0)) return addMulUnitMulx(r, a, n, m);
+      return addMulUnitLoop(r, a, n, m);
+    }
+#else
+   static Unit addMulUnit (Unit * r, const Unit * a, long n, Unit m)
+    {
+      return addMulUnitLoop(r, a, n, m);
+    }
+#endif
+
+    /* r = r - a * m, returns the borrow out. */
+   static Unit subMulUnit (Unit * r, const Unit * a, long n, Unit m)
+    {
+      unsigned NEXT_TYPE temp;
+      Unit borrow = 0, low;
+
+      for (long i = 0; i < n; i++)
+       {
+         temp = (unsigned NEXT_TYPE)a[i] * m + borrow;
+         low = (Unit)temp;
+         borrow = (Unit)(temp >> BitField::bits);
+         if (r[i] < low) borrow++;
+         r[i] -= low;
+       }
+
+      return borrow;
+    }
+
+    /*
+      One step of division by d, which has its top bit set: divides r:u by d
+      where r < d, returns the quotient and leaves the remainder in r. v is
+      the reciprocal floor((B^2 - 1) / d) - B, where B is 2^bits.
+    */
+   static inline Unit divStep (Unit & r, Unit u, Unit d, Unit v)
+    {
+      unsigned NEXT_TYPE q = (unsigned NEXT_TYPE)v * r +
+         ((((unsigned NEXT_TYPE)(r + 1)) << BitField::bits) | u);
+      Unit qhigh = (Unit)(q >> BitField::bits), qlow = (Unit)q;
+
+      r = u - qhigh * d;
+      if (r > qlow)
+       {
+         qhigh--;
+         r += d;
+       }
+      if (r >= d)
+       {
+         qhigh++;
+         r -= d;
+       }
+
+      return qhigh;
+    }
+
+    /*
+      q = a / d, returns the remainder. q may be a. d is shifted up until its
+      top bit is set, and a goes up with it a Unit at a time.
+    */
+   static Unit divUnit (Unit * q, const Unit * a, long n, Unit d)
+    {
+      int s = 0;
+      while ((d >> (BitField::bits - 1)) == 0)
+       {
+         d <<= 1;
+         s++;
+       }
+
+      Unit v = (Unit)(~(unsigned NEXT_TYPE)0 / d), r = 0;
+
+      if (s == 0)
+       {
+         for (long i = n - 1; i >= 0; i--)
+            q[i] = divStep(r, a[i], d, v);
+         return r;
+       }
+
+      r = a[n - 1] >> (BitField::bits - s);
+      for (long i = n - 1; i > 0; i--)
+         q[i] = divStep(r, (a[i] << s) | (a[i - 1] >> (BitField::bits - s)),
+                        d, v);
+      q[0] = divStep(r, a[0] << s, d, v);
+
+      return r >> s;
+    }
+
+
+
+    /*
+      Note that neither this nor >>= support negative amounts.
+    */
+   void BitField::operator <<= (long amount)
+    {
+      long addedUnits = amount / bits;
+      int shiftAmount = amount % bits;
+      int rightShift = bits - shiftAmount;
+      long newLength;
+      Unit carry = 0, oldCarry;
+
+       /* Are we essentially doing nothing? */
+      if (Zero || (amount == 0)) return;
+
+      own(addedUnits + 1);
+
+       /*
+         Shift the data. We do the remainder mod bits here, as the quotient
+         is just the number of Units we need to add to the number.
+       */
+      if (shiftAmount != 0)
+       {
+         for (long i = 0; i < Data->Length; i++)
+          {
+            oldCarry = carry;
+            carry = Data->Data[i] >> rightShift;
+            Data->Data[i] = (Data->Data[i] << shiftAmount) | oldCarry;
+          }
+       }
+
+      if ((addedUnits != 0) || (carry != 0))
+       {
+         newLength = Data->Length + addedUnits + (carry == 0 ? 0 : 1);
+         reserve(newLength);
+
+         if (addedUnits != 0)
+          {
+            std::memmove(Data->Data + addedUnits, Data->Data,
+               Data->Length * sizeof(Unit));
+            std::memset(Data->Data, '\0', addedUnits * sizeof(Unit));
+          }
+
+         Data->Length = newLength;
+         if (carry != 0) Data->Data[Data->Length - 1] = carry;
+       }
+    }
+
+   void BitField::operator >>= (long amount)
+    {
+      long lessUnits = amount / bits;
+      int shiftAmount = amount % bits;
+      int leftShift = bits - shiftAmount;
+      Unit carry = 0, oldCarry;
+
+      if ((Zero) || (amount == 0)) return;
+
+       /* Are we just making ourself Zero? */
+      if (lessUnits >= Data->Length)
+       {
+         release();
+         return;
+       }
+
+      own();
+
+      if (lessUnits != 0)
+       {
+         Data->Length -= lessUnits;
+         std::memmove(Data->Data, Data->Data + lessUnits,
+            Data->Length * sizeof(Unit));
+       }
+
+      if (shiftAmount != 0)
+       {
+         for (long i = Data->Length - 1; i >= 0 ; i--)
+          {
+            oldCarry = carry;
+            carry = (Data->Data[i] << leftShift) & mask;
+            Data->Data[i] = (Data->Data[i] >> shiftAmount) | oldCarry;
+          }
+       }
+
+      if (Data->Data[Data->Length - 1] == 0)
+       {
+         Data->Length--;
+         if (Data->Length == 0) release();
+       }
+    }
+
+
+
+   void BitField::operator = (const BitField & src)
+    {
+      if (&src == this) return;
+      release(); //make us zero
+      share(src);
+    }
+
+   void BitField::operator = (BitField && src)
+    {
+      if (&src == this) return;
+      release();
+      take(src);
+    }
+
+
+
+   void BitField::operator -= (const BitField & rhs)
+    {
+      if (rhs.isZero()) return; //We only test if we are subtracting zero.
+       /*
+         We could add a compare here, and early-out if lhs == rhs : zero.
+         We could then add an error check as rhs > lhs is not supported.
+         Most of the time, though, this is just going to waste time, and
+         Integer should never raise the error condition, so don't do it.
+       */
+
+      long i;
+
+      own();
+
+      subFrom(Data->Data, Data->Length, rhs.Data->Data, rhs.Data->Length);
+
+      if (Data->Data[Data->Length - 1] == 0)
+       {
+         for (i = Data->Length - 1; (i >= 0) && (Data->Data[i] == 0); i--) ;
+         Data->Length = i + 1;
+
+         if (i == -1) release(); //Are we Zero?
+       }
+    }
+
+   void BitField::operator += (const BitField & rhs)
+    {
+      if (rhs.isZero()) return; //Simple case 1: we are adding zero
+      if (Zero) //Simple case 2: something is being added to zero
+       {
+         share(rhs);
+         return;
+       }
+
+      Unit carry;
+
+       /*
+         For simplicity's sake, we add the smaller number to the larger.
+         This may require us to clone the larger, which we'd have to do
+         anyway, but with more complex logic.
+       */
+      if (Data->Length < rhs.Data->Length)
+       {
+         BitField larger (rhs);
+         larger += *this;
+         release();
+         share(larger);
+         return;
+       }
+
+      own(1);
+
+      carry = addInto(Data->Data, Data->Length,
+                      rhs.Data->Data, rhs.Data->Length);
+
+      if (carry != 0)
+       {
+         reserve(Data->Length + 1);
+
+         Data->Data[Data->Length] = carry;
+         Data->Length++;
+       }
+    }
+
+
+
+   void BitField::operator += (Unit carry)
+    {
+      if (carry == 0) return;
+
+      if (Zero)
+       {
+         allocate(1);
+         Data->Data[0] = carry;
+         return;
+       }
+      own(1);
+
+      Unit add = carry;
+      carry = addInto(Data->Data, Data->Length, &add, 1);
+
+      if (carry != 0)
+       {
+         reserve(Data->Length + 1);
+
+         Data->Data[Data->Length] = carry;
+         Data->Length++;
+       }
+    }
+
+
+
+   void BitField::operator *= (Unit mult)
+    {
+      if (Zero || (mult == 1)) return; // Simple cases 1 + 2
+       // 1: 0 * x = 0
+       // 2: x * 1 = x
+
+      if (mult == 0) // Simple case 3: x * 0 = 0
+       {
+         release();
+         return;
+       }
+
+      own(1);
+
+      Unit carry = mulUnit(Data->Data, Data->Data, Data->Length, mult);
+
+      if (carry != 0)
+       {
+         reserve(Data->Length + 1);
+
+         Data->Data[Data->Length] = carry;
+         Data->Length++;
+       }
+    }
+
+    /*
+      This is a little wierd. We do the division, mutating the BitField,
+      and return the remainder. This convention makes perfect sense in
+      Integer::toString().
+    */
+   Unit BitField::operator /= (Unit divisor)
+    {
+      if (Zero) return 0; // There's really no good behavior for this.
+       // Throwing exceptions is NOT good behavior.
+
+      own();
+
+      Unit rem = divUnit(Data->Data, Data->Data, Data->Length, divisor);
+
+      if (Data->Data[Data->Length - 1] == 0)
+       {
+         Data->Length--;
+         if (Data->Length == 0) release();
+       }
+
+      return rem;
+    }
+
+
+
+    /*
+      Multiplication of whole BitFields.
+
+      Integer used to do long multiplication a row at a time with the
+      operators above: copy, multiply by a Unit, shift, and add. That is four
+      passes over the data for every Unit of the smaller number. These work
+      directly on the Unit arrays instead, and pick an algorithm by size:
+
+         schoolbook     O(n^2)      below KaratsubaCutoff Units
+         Karatsuba      O(n^1.585)  below ToomCookCutoff Units
+         Toom-Cook 3    O(n^1.465)  below NttCutoff Units
+         NTT            O(n log n)  above that, with 64-bit Units
+
+      The cutoffs were found by timing on x86-64 with 64-bit Units. Operands
+      of very different lengths are cut into pieces the size of the smaller
+      one, so that the recursive algorithms always see balanced operands.
+      The recursions only make progress with cutoffs of at least four and
+      six Units, respectively.
+
+      None of these routines normalize: the result array is always exactly
+      an + bn Units long, and the top Unit may be zero.
+    */
+   const static long KaratsubaCutoff = 32;
+   const static long ToomCookCutoff = 160;
+
+   static void mulUnits (Unit *, const Unit *, long, const Unit *, long);
+
+    /* r = a * b, the O(n^2) way. */
+   static void mulSchool (Unit * r, const Unit * a, long an,
+                          const Unit * b, long bn)
+    {
+      r[an] = mulUnit(r, a, an, b[0]);
+      for (long j = 1; j < bn; j++)
+         r[an + j] = addMulUnit(r + j, a, an, b[j]);
+    }
+
+    /*
+      r = a * b, where bn > (an + 1) / 2.
+      With x = 2^(bits * k): a = a1 * x + a0 and b = b1 * x + b0, so
+         a * b = a1b1 * x^2 + ((a0 + a1)(b0 + b1) - a0b0 - a1b1) * x + a0b0
+      Three multiplications of half the size instead of four.
+    */
+   static void mulKaratsuba (Unit * r, const Unit * a, long an,
+                             const Unit * b, long bn)
+    {
+      long k = (an + 1) / 2, rn = an + bn, size = 4 * k + 4;
+      Unit * sa = newUnits(size), * sb = sa + k + 1, * t = sb + k + 1;
+
+      mulUnits(r, a, k, b, k);
+      mulUnits(r + 2 * k, a + k, an - k, b + k, bn - k);
+
+      sa[k] = addUnits(sa, a, k, a + k, an - k);
+      sb[k] = addUnits(sb, b, k, b + k, bn - k);
+      mulUnits(t, sa, k + 1, sb, k + 1);
+
+      subFrom(t, 2 * k + 2, r, 2 * k);
+      subFrom(t, 2 * k + 2, r + 2 * k, rn - 2 * k);
+
+       /* Anything in t that would go past the end of r is zero. */
+      addInto(r + k, rn - k, t, (2 * k + 2 < rn - k) ? 2 * k + 2 : rn - k);
+
+      deleteUnits(sa, size);
+    }
+
+    /*
+      Toom-Cook 3 works on fixed-width two's complement numbers, because
+      the evaluation at -1 and -2 and the interpolation have negative
+      intermediate results. These are the helpers for that.
+    */
+   static void tcLoad (Unit * r, long n, const Unit * a, long an)
+    {
+      if (an > n) an = n;
+      if (an > 0) std::memcpy(r, a, an * sizeof(Unit));
+      if (n > an) std::memset(r + an, '\0', (n - an) * sizeof(Unit));
+    }
+
+   static bool tcIsNegative (const Unit * a, long n)
+    {
+      return (a[n - 1] >> (BitField::bits - 1)) != 0;
+    }
+
+   static void tcNegate (Unit * r, long n)
+    {
+      Unit carry = 1;
+      for (long i = 0; i < n; i++)
+       {
+         r[i] = ~r[i] + carry;
+         carry = ((r[i] == 0) && (carry != 0)) ? 1 : 0;
+       }
+    }
+
+    /* Arithmetic shift right by one bit. */
+   static void tcHalve (Unit * r, long n)
+    {
+      Unit top = r[n - 1] & (((Unit)1) << (BitField::bits - 1));
+      for (long i = 0; i < n - 1; i++)
+         r[i] = (r[i] >> 1) | (r[i + 1] << (BitField::bits - 1));
+      r[n - 1] = (r[n - 1] >> 1) | top;
+    }
+
+    /*
+      Exact division by three: multiply by the inverse of three modulo the
+      radix, limb by limb, from the bottom up. This gives the quotient
+      modulo 2^(bits * n), which is the quotient if the division is exact.
+    */
+   static void tcThird (Unit * r, long n)
+    {
+      const Unit inverse = (Unit)(((unsigned NEXT_TYPE)mask / 3) * 2 + 1);
+      Unit carry = 0, borrow, temp;
+
+      for (long i = 0; i < n; i++)
+       {
+         temp = r[i];
+         borrow = (temp < carry) ? 1 : 0;
+         temp -= carry;
+         r[i] = temp * inverse;
+         carry = (Unit)(((unsigned NEXT_TYPE)r[i] * 3) >> BitField::bits) +
+            borrow;
+       }
+    }
+
+    /*
+      r = a * b, with a and b cut in thirds.
+      Evaluate at 0, 1, -1, -2, and infinity, multiply the five pairs, and
+      interpolate the five coefficients of the product. The interpolation
+      sequence is Bodrato's.
+    */
+   static void mulToomCook (Unit * r, const Unit * a, long an,
+                            const Unit * b, long bn)
+    {
+      long k = (an + 2) / 3, rn = an + bn, i;
+      long L = k + 2, W = 2 * L;
+      long b0n, b1n, b2n;
+
+      b0n = (bn < k) ? bn : k;
+      b1n = (bn - k < 0) ? 0 : ((bn - k > k) ? k : bn - k);
+      b2n = (bn - 2 * k < 0) ? 0 : bn - 2 * k;
+
+      Unit * scratch = new Unit [6 * L + 4 * W];
+      Unit * ea = scratch, * eb = ea + L, * ta = eb + L, * tb = ta + L;
+      Unit * ma = tb + L, * mb = ma + L;
+      Unit * r1 = mb + L, * rm1 = r1 + W, * rm2 = rm1 + W, * t = rm2 + W;
+      bool signA, signB, square = (a == b) && (an == bn);
+
+       /* r(0) and r(inf) go straight into the result. */
+      mulUnits(r, a, k, b, b0n);
+      if (b0n < k) std::memset(r + k + b0n, '\0', (k - b0n) * sizeof(Unit));
+      std::memset(r + 2 * k, '\0', (rn - 2 * k) * sizeof(Unit));
+      if (b2n != 0) mulUnits(r + 4 * k, a + 2 * k, an - 2 * k, b + 2 * k, b2n);
+
+       /* ta = a0 + a2, and tb = b0 + b2 */
+      tcLoad(ta, L, a, k);
+      addInto(ta, L, a + 2 * k, an - 2 * k);
+      tcLoad(tb, L, b, b0n);
+      addInto(tb, L, b + 2 * k, b2n);
+
+       /* r(1) */
+      tcLoad(ea, L, ta, L);
+      addInto(ea, L, a + k, k);
+      tcLoad(eb, L, tb, L);
+      addInto(eb, L, b + k, b1n);
+      mulUnits(r1, ea, L, square ? ea : eb, L);
+
+       /* r(-1) */
+      tcLoad(ma, L, ta, L);
+      subFrom(ma, L, a + k, k);
+      tcLoad(mb, L, tb, L);
+      subFrom(mb, L, b + k, b1n);
+
+      tcLoad(ea, L, ma, L);
+      tcLoad(eb, L, mb, L);
+      signA = tcIsNegative(ea, L);
+      signB = tcIsNegative(eb, L);
+      if (signA) tcNegate(ea, L);
+      if (signB) tcNegate(eb, L);
+      mulUnits(rm1, ea, L, square ? ea : eb, L);
+      if (signA != signB) tcNegate(rm1, W);
+
+       /* r(-2): ((a0 - a1 + a2) + a2) * 2 - a0 */
+      addInto(ma, L, a + 2 * k, an - 2 * k);
+      addInto(ma, L, ma, L);
+      subFrom(ma, L, a, k);
+      addInto(mb, L, b + 2 * k, b2n);
+      addInto(mb, L, mb, L);
+      subFrom(mb, L, b, b0n);
+
+      signA = tcIsNegative(ma, L);
+      signB = tcIsNegative(mb, L);
+      if (signA) tcNegate(ma, L);
+      if (signB) tcNegate(mb, L);
+      mulUnits(rm2, ma, L, square ? ma : mb, L);
+      if (signA != signB) tcNegate(rm2, W);
+
+       /*
+         Interpolate, in place:
+            r3 = (r(-2) - r(1)) / 3          -> rm2
+            r1 = (r(1) - r(-1)) / 2          -> r1
+            r2 = r(-1) - r(0)                -> rm1
+            r3 = (r2 - r3) / 2 + 2 * r(inf)  -> rm2
+            r2 = r2 + r1 - r(inf)            -> rm1
+            r1 = r1 - r3                     -> r1
+       */
+      subFrom(rm2, W, r1, W);
+      tcThird(rm2, W);
+
+      subFrom(r1, W, rm1, W);
+      tcHalve(r1, W);
+
+      tcLoad(t, W, r, 2 * k);
+      subFrom(rm1, W, t, W);
+
+      tcLoad(t, W, rm1, W);
+      subFrom(t, W, rm2, W);
+      tcHalve(t, W);
+      tcLoad(rm2, W, t, W);
+      tcLoad(t, W, r + 4 * k, rn - 4 * k);
+      addInto(rm2, W, t, W);
+      addInto(rm2, W, t, W);
+
+      addInto(rm1, W, r1, W);
+      subFrom(rm1, W, t, W);
+
+      subFrom(r1, W, rm2, W);
+
+       /*
+         The three middle coefficients are all non-negative now. Add them
+         in. Whatever would land past the end of r is zero.
+       */
+      for (i = 1; i <= 3; i++)
+       {
+         Unit * c = (i == 1) ? r1 : ((i == 2) ? rm1 : rm2);
+         long cn = (W < rn - i * k) ? W : rn - i * k;
+         addInto(r + i * k, rn - i * k, c, cn);
+       }
+
+      delete [] scratch;
+    }
+
+#ifndef BIG_INT_QUAD_BYTE
+
+    /*
+      Above NttCutoff Units, even Toom-Cook is too slow, and we multiply
+      with number-theoretic transforms instead. The product of two Units is
+      less than 2^128, so a coefficient of the convolution of n Units is
+      less than n * 2^128. We do the convolution modulo three primes that
+      are just under 2^61, and put each coefficient back together with the
+      Chinese Remainder Theorem: their product is about 2^183, which is good
+      for up to 2^55 Units.
+
+      Each prime is c * 2^40 + 1, so transforms can be up to 2^40 long. The
+      arithmetic is Montgomery multiplication with R = 2^64. The forward
+      transform is decimation in frequency, which leaves its output in
+      bit-reversed order; the inverse transform is decimation in time, which
+      takes its input in bit-reversed order. So we never have to permute.
+
+      This needs 64-bit Units and a 128-bit NEXT_TYPE. With 32-bit Units,
+      we stop at Toom-Cook.
+    */
+   const static long NttCutoff = 7168;
+
+   struct NttPrime
+    {
+      Unit p;          // the prime
+      Unit g;          // a primitive root modulo p
+      Unit negInverse; // -1 / p modulo 2^64
+      Unit r2;         // 2^128 modulo p
+    };
+
+   const static NttPrime NttPrimes [3] =
+    {
+      { 2305835312632299521ULL,  3ULL, 2305835312632299519ULL,   41253674629982928ULL },
+      { 2305804526306721793ULL,  5ULL, 2305804526306721791ULL, 1030498540330518661ULL },
+      { 2305778138027655169ULL, 13ULL, 2305778138027655167ULL, 1030976752187202484ULL }
+    };
+
+    /*
+      Constants for Garner's algorithm. The inverses are in Montgomery form,
+      so that nttMul by them is multiplication by the inverse.
+    */
+   const static Unit NttP1InvP2 = 1317602586461583068ULL;
+   const static Unit NttP1InvP3 = 354735098158423434ULL;
+   const static Unit NttP2InvP3 = 768592712676584107ULL;
+   const static Unit NttP1P2Low = 4611639838939021313ULL;
+   const static Unit NttP1P2High = 288224603731722240ULL;
+
+    /*
+      Montgomery reduction of a * b. a * b must be less than p * 2^64,
+      which is true whenever one of them is reduced.
+    */
+   static inline Unit nttMul (Unit a, Unit b, const NttPrime & P)
+    {
+      unsigned NEXT_TYPE t = (unsigned NEXT_TYPE)a * b;
+      Unit m = (Unit)t * P.negInverse;
+      Unit u = (Unit)((t + (unsigned NEXT_TYPE)m * P.p) >> BitField::bits);
+      return (u >= P.p) ? u - P.p : u;
+    }
+
+   static Unit nttPow (Unit base, Unit exp, const NttPrime & P)
+    {
+      Unit result = nttMul(1, P.r2, P); // one, in Montgomery form
+      while (exp != 0)
+       {
+         if (exp & 1) result = nttMul(result, base, P);
+         base = nttMul(base, base, P);
+         exp >>= 1;
+       }
+      return result;
+    }
+
+    /*
+      The roots of unity for a butterfly of half-length h are in
+      roots[h .. 2h - 1], so that each pass reads its roots in order:
+      roots[h + j] is v^j, where v is a primitive 2h-th root of unity.
+      The inverse transform is given the table for the inverse root.
+    */
+   static void nttRoots (Unit * roots, long n, Unit w, const NttPrime & P)
+    {
+      Unit x = nttMul(1, P.r2, P);
+      long i, h;
+
+      for (i = 0; i < n / 2; i++)
+       {
+         roots[n / 2 + i] = x;
+         x = nttMul(x, w, P);
+       }
+      for (h = n / 4; h >= 1; h >>= 1)
+         for (i = 0; i < h; i++)
+            roots[h + i] = roots[2 * h + 2 * i];
+    }
+
+   static void nttForward (Unit * a, long n, const Unit * roots,
+                           const NttPrime & P)
+    {
+      Unit u, v;
+      for (long half = n >> 1; half >= 1; half >>= 1)
+       {
+         for (long s = 0; s < n; s += 2 * half)
+          {
+            for (long j = 0; j < half; j++)
+             {
+               u = a[s + j];
+               v = a[s + j + half];
+               a[s + j] = (u + v >= P.p) ? u + v - P.p : u + v;
+               a[s + j + half] = nttMul((u >= v) ? u - v : u + P.p - v,
+                                        roots[half + j], P);
+             }
+          }
+       }
+    }
+
+   static void nttInverse (Unit * a, long n, const Unit * roots,
+                           const NttPrime & P)
+    {
+      Unit u, v;
+      for (long half = 1; half < n; half <<= 1)
+       {
+         for (long s = 0; s < n; s += 2 * half)
+          {
+            for (long j = 0; j < half; j++)
+             {
+               u = a[s + j];
+               v = nttMul(a[s + j + half], roots[half + j], P);
+               a[s + j] = (u + v >= P.p) ? u + v - P.p : u + v;
+               a[s + j + half] = (u >= v) ? u - v : u + P.p - v;
+             }
+          }
+       }
+    }
+
+    /*
+      c = a * b modulo P, as a cyclic convolution of length n.
+      c is left in Montgomery form, scaled by n.
+    */
+   static void nttConvolve (Unit * c, const Unit * a, long an,
+                            const Unit * b, long bn, long n, Unit * scratch,
+                            const NttPrime & P)
+    {
+      Unit * fb = scratch, * roots = scratch + n, w;
+      long i;
+
+       /* The Montgomery multiply by 2^128 both reduces and converts. */
+      for (i = 0; i < an; i++) c[i] = nttMul(a[i], P.r2, P);
+      for (; i < n; i++) c[i] = 0;
+
+      w = nttPow(nttMul(P.g, P.r2, P), (P.p - 1) / (Unit)n, P);
+      nttRoots(roots, n, w, P);
+
+      nttForward(c, n, roots, P);
+
+       /* A square only needs the one transform. */
+      if ((a == b) && (an == bn))
+       {
+         for (i = 0; i < n; i++) c[i] = nttMul(c[i], c[i], P);
+       }
+      else
+       {
+         for (i = 0; i < bn; i++) fb[i] = nttMul(b[i], P.r2, P);
+         for (; i < n; i++) fb[i] = 0;
+
+         nttForward(fb, n, roots, P);
+         for (i = 0; i < n; i++) c[i] = nttMul(c[i], fb[i], P);
+       }
+
+       /* The inverse root is w^(n - 1). */
+      nttRoots(roots, n, nttPow(w, (Unit)n - 1, P), P);
+      nttInverse(c, n, roots, P);
+    }
+
+    /* The length of the transform for a product of rn Units. */
+   static long nttLength (long rn)
+    {
+      long n = 1;
+      while (n < rn - 1) n <<= 1;
+      return n;
+    }
+
+    /*
+      The transform length is a power of two, so a product just over a power
+      of two wastes half of it. Toom-Cook is faster then, until the numbers
+      get big enough for the asymptotics to pay for the padding.
+    */
+   static bool useNtt (long an, long bn)
+    {
+      if (bn < NttCutoff) return false;
+      if (bn >= 4 * NttCutoff) return true;
+      return 2 * nttLength(an + bn) <= 3 * (an + bn);
+    }
+
+    /*
+      r = a * b, by three transforms and the Chinese Remainder Theorem.
+    */
+   static void mulNtt (Unit * r, const Unit * a, long an,
+                       const Unit * b, long bn)
+    {
+      long rn = an + bn, n = nttLength(rn), i, j;
+      Unit * c [3], * scratch, nInverse [3];
+      unsigned NEXT_TYPE carry = 0, t, low;
+      Unit v1, v2, v3, x0, x1, x2;
+
+      c[0] = new Unit [5 * n];
+      c[1] = c[0] + n;
+      c[2] = c[1] + n;
+      scratch = c[2] + n;
+
+      for (j = 0; j < 3; j++)
+       {
+         nttConvolve(c[j], a, an, b, bn, n, scratch, NttPrimes[j]);
+          /*
+            nttMul(x, 1 / n) takes x out of Montgomery form and removes the
+            factor of n in one go. 1 / n is p - (p - 1) / n.
+          */
+         nInverse[j] = NttPrimes[j].p - (NttPrimes[j].p - 1) / (Unit)n;
        }
 
-      if ((addedUnits != 0) || (carry != 0))
+      for (i = 0; i < rn; i++)
        {
-         newLength = Data->Length + addedUnits + (carry == 0 ? 0 : 1);
-         if (newLength > Data->Size)
+         if (i < rn - 1)
           {
-            newData = new Unit [newLength];
-
-            std::memcpy(newData + addedUnits, Data->Data,
-               Data->Length * sizeof(Unit));
-            if (addedUnits != 0)
-               std::memset(newData, '\0', addedUnits * sizeof(Unit));
-
-            delete [] Data->Data;
-            Data->Data = newData;
-            newData = NULL;
-
-            Data->Size = newLength;
+            v1 = nttMul(c[0][i], nInverse[0], NttPrimes[0]);
+            v2 = nttMul(c[1][i], nInverse[1], NttPrimes[1]);
+            v3 = nttMul(c[2][i], nInverse[2], NttPrimes[2]);
+
+             /*
+              v2 = (r2 - v1) / p1 modulo p2
+              v3 = ((r3 - v1) / p1 - v2) / p2 modulo p3
+              The primes are close enough that a residue of one of them
+              is reduced modulo another by one subtraction.
+            */
+            x0 = (v1 >= NttPrimes[1].p) ? v1 - NttPrimes[1].p : v1;
+            v2 = (v2 >= x0) ? v2 - x0 : v2 + NttPrimes[1].p - x0;
+            v2 = nttMul(v2, NttP1InvP2, NttPrimes[1]);
+
+            x0 = (v1 >= NttPrimes[2].p) ? v1 - NttPrimes[2].p : v1;
+            v3 = (v3 >= x0) ? v3 - x0 : v3 + NttPrimes[2].p - x0;
+            v3 = nttMul(v3, NttP1InvP3, NttPrimes[2]);
+            x0 = (v2 >= NttPrimes[2].p) ? v2 - NttPrimes[2].p : v2;
+            v3 = (v3 >= x0) ? v3 - x0 : v3 + NttPrimes[2].p - x0;
+            v3 = nttMul(v3, NttP2InvP3, NttPrimes[2]);
+
+             /* x = v1 + v2 * p1 + v3 * p1 * p2, in three Units */
+            t = (unsigned NEXT_TYPE)v2 * NttPrimes[0].p + v1;
+            low = (unsigned NEXT_TYPE)v3 * NttP1P2Low + (Unit)t;
+            x0 = (Unit)low;
+            t = (t >> BitField::bits) + (low >> BitField::bits) +
+               (unsigned NEXT_TYPE)v3 * NttP1P2High;
+            x1 = (Unit)t;
+            x2 = (Unit)(t >> BitField::bits);
           }
          else
           {
-            if (addedUnits != 0)
-             {
-               std::memmove(Data->Data + addedUnits, Data->Data,
-                  Data->Length * sizeof(Unit));
-               std::memset(Data->Data, '\0', addedUnits * sizeof(Unit));
-             }
+            x0 = x1 = x2 = 0;
           }
 
-         Data->Length = newLength;
-         if (carry != 0) Data->Data[Data->Length - 1] = carry;
+         t = (unsigned NEXT_TYPE)x0 + (Unit)carry;
+         r[i] = (Unit)t;
+         carry = (carry >> BitField::bits) + (t >> BitField::bits) +
+            (((unsigned NEXT_TYPE)x2 << BitField::bits) | x1);
        }
-    }
-
-   void BitField::operator >>= (long amount)
-    {
-      long lessUnits = amount / bits;
-      int shiftAmount = amount % bits;
-      int leftShift = bits - shiftAmount;
-      Unit carry = 0, oldCarry;
 
-      if ((Zero) || (amount == 0)) return;
+      delete [] c[0];
+    }
 
-       /* Are we just making ourself Zero? */
-      if (lessUnits >= Data->Length)
-       {
-         Data->Refs--;
-         if (Data->Refs == 0) delete Data;
+#endif /* ! BIG_INT_QUAD_BYTE */
 
-         Data = NULL;
-         Zero = true;
-         return;
-       }
+    /*
+      Squaring. Half of the products in a * a are the same: a[i] * a[j] and
+      a[j] * a[i]. So the schoolbook square finds each of those once,
+      doubles their sum, and adds the a[i]^2 down the diagonal. Karatsuba
+      squares three half-size pieces, and Toom-Cook and the NTT notice that
+      they have been given the same number twice. The schoolbook square is
+      nearly twice as fast as the schoolbook multiply, so the cutoffs are
+      higher for squares.
+    */
+   const static long SqrKaratsubaCutoff = 48;
+   const static long SqrToomCookCutoff = 256;
 
-      if (Data->Refs != 1)
-       {
-         Data->Refs--;
-         Data = new BitHolder (*Data);
-       }
+    /* r = a * a, the O(n^2) way. */
+   static void sqrSchool (Unit * r, const Unit * a, long n)
+    {
+      unsigned NEXT_TYPE temp;
+      Unit carry, top, high;
+      long i;
 
-      if (lessUnits != 0)
+       /* The products above the diagonal. */
+      r[0] = 0;
+      r[2 * n - 1] = 0;
+      if (n > 1)
        {
-         Data->Length -= lessUnits;
-         std::memmove(Data->Data, Data->Data + lessUnits,
-            Data->Length * sizeof(Unit));
+         r[n] = mulUnit(r + 1, a + 1, n - 1, a[0]);
+         for (i = 1; i < n - 1; i++)
+            r[n + i] = addMulUnit(r + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
        }
 
-      if (shiftAmount != 0)
+       /* Twice them. */
+      carry = 0;
+      for (i = 0; i < 2 * n; i++)
        {
-         for (long i = Data->Length - 1; i >= 0 ; i--)
-          {
-            oldCarry = carry;
-            carry = (Data->Data[i] << leftShift) & mask;
-            Data->Data[i] = (Data->Data[i] >> shiftAmount) | oldCarry;
-          }
+         top = r[i] >> (BitField::bits - 1);
+         r[i] = (r[i] << 1) | carry;
+         carry = top;
        }
 
-      if (Data->Data[Data->Length - 1] == 0)
+       /* Plus the diagonal. */
+      carry = 0;
+      for (i = 0; i < n; i++)
        {
-         Data->Length--;
-         if (Data->Length == 0)
-          {
-            delete Data; //We know that Refs == 0 now.
-
-            Data = NULL;
-            Zero = true;
-          }
+         temp = (unsigned NEXT_TYPE)a[i] * a[i];
+         high = (Unit)(temp >> BitField::bits);
+
+         temp = (unsigned NEXT_TYPE)r[2 * i] + (Unit)temp + carry;
+         r[2 * i] = (Unit)temp;
+         temp = (unsigned NEXT_TYPE)r[2 * i + 1] + high +
+            (Unit)(temp >> BitField::bits);
+         r[2 * i + 1] = (Unit)temp;
+         carry = (Unit)(temp >> BitField::bits);
        }
     }
 
-
-
-   void BitField::operator = (const BitField & src)
+    /*
+      r = a * a. With x = 2^(bits * k) and a = a1 * x + a0,
+         a * a = a1^2 * x^2 + (a0^2 + a1^2 - (a0 - a1)^2) * x + a0^2
+      Taking |a0 - a1| keeps everything positive and k Units long.
+    */
+   static void sqrKaratsuba (Unit * r, const Unit * a, long n)
     {
-      if (&src == this) return;
-      if (!Zero) //then make us zero
-       {
-         Data->Refs--;
-         if (Data->Refs == 0) delete Data;
+      long k = (n + 1) / 2, size = 5 * k + 1;
+      Unit * d = newUnits(size), * m = d + k, * t = m + 2 * k;
 
-         Data = NULL;
-         Zero = true;
-       }
-      if (src.isZero()) return;
-      Data = src.Data;
-      src.Data->Refs++;
-      Zero = false;
-    }
+      mulUnits(r, a, k, a, k);
+      mulUnits(r + 2 * k, a + k, n - k, a + k, n - k);
 
+      std::memcpy(d, a, k * sizeof(Unit));
+      if (subFrom(d, k, a + k, n - k) != 0) tcNegate(d, k);
+      mulUnits(m, d, k, d, k);
 
+      std::memcpy(t, r, 2 * k * sizeof(Unit));
+      t[2 * k] = 0;
+      addInto(t, 2 * k + 1, r + 2 * k, 2 * (n - k));
+      subFrom(t, 2 * k + 1, m, 2 * k);
 
-   void BitField::operator -= (const BitField & rhs)
-    {
-      if (rhs.isZero()) return; //We only test if we are subtracting zero.
-       /*
-         We could add a compare here, and early-out if lhs == rhs : zero.
-         We could then add an error check as rhs > lhs is not supported.
-         Most of the time, though, this is just going to waste time, and
-         Integer should never raise the error condition, so don't do it.
-       */
+       /* Anything in t that would go past the end of r is zero. */
+      addInto(r + k, 2 * n - k, t,
+         (2 * k + 1 < 2 * n - k) ? 2 * k + 1 : 2 * n - k);
 
-      Unit carry = 0;
-      NEXT_TYPE temp;
-      long i;
+      deleteUnits(d, size);
+    }
 
-      if (Data->Refs != 1)
+   static void sqrUnits (Unit * r, const Unit * a, long n)
+    {
+      if (n < SqrKaratsubaCutoff)
        {
-         Data->Refs--;
-         Data = new BitHolder (*Data);
+         sqrSchool(r, a, n);
        }
-
-      for (i = 0; i < rhs.Data->Length; i++)
+#ifndef BIG_INT_QUAD_BYTE
+      else if (useNtt(n, n))
        {
-         temp = (NEXT_TYPE)Data->Data[i] - rhs.Data->Data[i] - carry;
-         Data->Data[i] = (Unit)(temp & mask);
-         carry = (Unit)(temp >> bits) & (Unit)1; // Borrow out is at most 1
+         mulNtt(r, a, n, a, n);
        }
-
-      for (; (i < Data->Length) && (carry != 0); i++)
+#endif /* ! BIG_INT_QUAD_BYTE */
+      else if (n < SqrToomCookCutoff)
        {
-         temp = (NEXT_TYPE)Data->Data[i] - carry;
-         Data->Data[i] = (Unit)(temp & mask);
-         carry = (Unit)(temp >> bits) & (Unit)1;
+         sqrKaratsuba(r, a, n);
        }
-
-      if (Data->Data[Data->Length - 1] == 0)
+      else
        {
-         for (i = Data->Length - 1; (i >= 0) && (Data->Data[i] == 0); i--) ;
-         Data->Length = i + 1;
-
-         if (i == -1) //Are we Zero?
-          {
-            delete Data;
-
-            Data = NULL;
-            Zero = true;
-          }
+         mulToomCook(r, a, n, a, n);
        }
     }
 
-   void BitField::operator += (const BitField & rhs)
+    /*
+      r = a * b, for any an and bn greater than zero. r must not overlap
+      either a or b. If a and b are the same number, it is squared.
+    */
+   static void mulUnits (Unit * r, const Unit * a, long an,
+                         const Unit * b, long bn)
     {
-      if (rhs.isZero()) return; //Simple case 1: we are adding zero
-      if (Zero) //Simple case 2: something is being added to zero
+      if ((a == b) && (an == bn))
        {
-         Data = rhs.Data;
-         Data->Refs++;
-         Zero = false;
+         sqrUnits(r, a, an);
          return;
        }
 
-      Unit * newData = NULL, carry = 0;
-      NEXT_TYPE temp;
-      long i;
-      BitHolder * tmp = NULL, * Rhs = NULL;
-      bool freeRhs = false;
-
-      Rhs = rhs.Data;
-
-       /*
-         For simplicity's sake, we add the smaller number to the larger.
-         This may require us to clone the larger, which we'd have to do
-         anyway, but with more complex logic.
-       */
-      if (Data->Length < Rhs->Length)
+      if (an < bn)
        {
-         tmp = Data;
-         Data = Rhs;
-         Rhs = tmp;
-         tmp = NULL;
+         const Unit * t = a;
+         a = b;
+         b = t;
 
-         freeRhs = true;
-         Data->Refs++;
+         long tn = an;
+         an = bn;
+         bn = tn;
        }
 
-      if (Data->Refs != 1)
+      if (bn < KaratsubaCutoff)
        {
-         Data->Refs--;
-         Data = new BitHolder (*Data, 1);
+         mulSchool(r, a, an, b, bn);
        }
-
-      for (i = 0; i < Rhs->Length; i++)
+#ifndef BIG_INT_QUAD_BYTE
+      else if (useNtt(an, bn))
        {
-         temp = (NEXT_TYPE)Data->Data[i] + Rhs->Data[i] + carry;
-         Data->Data[i] = (Unit)(temp & mask);
-         carry = (Unit)(temp >> bits);
+         mulNtt(r, a, an, b, bn);
        }
+#endif /* ! BIG_INT_QUAD_BYTE */
+      else if (an + 1 >= 2 * bn)
+       {
+          /* Unbalanced: multiply b by pieces of a that are as long as b. */
+         Unit * t = new Unit [2 * bn];
+         long i, piece;
 
-      for (; (i < Data->Length) && (carry != 0); i++)
+         std::memset(r, '\0', (an + bn) * sizeof(Unit));
+         for (i = 0; i < an; i += bn)
+          {
+            piece = (an - i < bn) ? an - i : bn;
+            mulUnits(t, a + i, piece, b, bn);
+            addInto(r + i, an + bn - i, t, piece + bn);
+          }
+
+         delete [] t;
+       }
+      else if ((bn < ToomCookCutoff) || (2 * an > 3 * bn))
        {
-         temp = (NEXT_TYPE)Data->Data[i] + carry;
-         Data->Data[i] = (Unit)(temp & mask);
-         carry = (Unit)(temp >> bits);
+         mulKaratsuba(r, a, an, b, bn);
        }
+      else
+       {
+         mulToomCook(r, a, an, b, bn);
+       }
+    }
 
-      if (carry != 0)
+   void BitField::operator *= (const BitField & rhs)
+    {
+      if (Zero) return;
+      if (rhs.isZero())
        {
-         if ((Data->Length + 1) > Data->Size)
-          {
-            newData = new Unit [Data->Length + 1];
+         release();
+         return;
+       }
 
-            std::memcpy(newData, Data->Data, Data->Length * sizeof(Unit));
+      BitField result;
+      long length = Data->Length + rhs.Data->Length;
 
-            delete [] Data->Data;
-            Data->Data = newData;
-            newData = NULL;
+      result.allocate(length);
 
-            Data->Size++;
-          }
+      mulUnits(result.Data->Data, Data->Data, Data->Length,
+         rhs.Data->Data, rhs.Data->Length);
 
-         Data->Data[Data->Length] = carry;
-         Data->Length++;
-       }
+      while (result.Data->Data[length - 1] == 0) length--;
+      result.Data->Length = length;
 
-      if (freeRhs)
-       {
-         Rhs->Refs--;
-         if (Rhs->Refs == 0) delete Rhs;
-       }
-      Rhs = NULL;
+       /* rhs may be this, so don't let go of our Data until now. */
+      release();
+      share(result);
     }
 
 
 
-   void BitField::operator += (Unit carry)
-    {
-      if (carry == 0) return;
-
-      Unit * newData = NULL;
-      NEXT_TYPE temp;
-      long i;
+    /*
+      Division of whole BitFields.
+
+      Integer used to do long division with the operators above: guess a
+      quotient digit from the top Units, then multiply, shift, compare, and
+      subtract whole BitFields. Like multiplication, this now works directly
+      on the Unit arrays. Below DivCutoff Units it is Knuth's Algorithm D.
+      Above that it is Burnikel and Ziegler's recursive division, which
+      turns most of the work into multiplications of half the size, and so
+      gets the benefit of Karatsuba, Toom-Cook, and NTT.
+
+      All of these expect a normalized divisor (the high bit of its top Unit
+      is set) of at least two Units, and a dividend whose top dn Units are
+      less than the divisor. The quotient is an - dn Units long, and the
+      remainder is left in the bottom dn Units of the dividend, with zeros
+      above it.
+    */
+   const static long DivCutoff = 32;
 
-      if (Zero)
+   static int compareUnits (const Unit * a, const Unit * b, long n)
+    {
+      for (long i = n - 1; i >= 0; i--)
        {
-         Zero = false;
-         Data = new BitHolder;
+         if (a[i] != b[i]) return (a[i] < b[i]) ? -1 : 1;
+       }
+      return 0;
+    }
 
-         Data->Data = new Unit [1];
-         Data->Length = 1;
-         Data->Size = 1;
-         Data->Refs = 1;
+    /*
+      r = a << s, for 0 <= s < bits. Returns the bits shifted out the top.
+      r may be a.
+    */
+   static Unit shiftUnitsLeft (Unit * r, const Unit * a, long n, int s)
+    {
+      Unit carry = 0, temp;
 
-         Data->Data[0] = carry;
-         return;
+      if (s == 0)
+       {
+         std::memmove(r, a, n * sizeof(Unit));
+         return 0;
        }
-      if (Data->Refs != 1)
+
+      for (long i = 0; i < n; i++)
        {
-         Data->Refs--;
-         Data = new BitHolder (*Data, 1);
+         temp = a[i];
+         r[i] = (temp << s) | carry;
+         carry = temp >> (BitField::bits - s);
        }
 
-      for (i = 0; (i < Data->Length) && (carry != 0); i++)
+      return carry;
+    }
+
+    /* r = a >> s, for 0 <= s < bits. r may be a. */
+   static void shiftUnitsRight (Unit * r, const Unit * a, long n, int s)
+    {
+      if (s == 0)
        {
-         temp = (NEXT_TYPE)Data->Data[i] + carry;
-         Data->Data[i] = (Unit)(temp & mask);
-         carry = (Unit)(temp >> bits);
+         std::memmove(r, a, n * sizeof(Unit));
+         return;
        }
 
-      if (carry != 0)
+      for (long i = 0; i < n - 1; i++)
+         r[i] = (a[i] >> s) | (a[i + 1] << (BitField::bits - s));
+      r[n - 1] = a[n - 1] >> s;
+    }
+
+    /*
+      Knuth's Algorithm D. Each quotient digit is guessed from the top two
+      Units of the divisor and top three of the running remainder, which
+      Knuth shows is never more than one too large after the correction
+      loop. When it is, the subtraction borrows, and we add one divisor back.
+    */
+   static void divSchool (Unit * q, Unit * a, long an, const Unit * d, long dn)
+    {
+      Unit top = d[dn - 1], secd = d[dn - 2], qhat, rhat;
+      bool overflow;
+
+      for (long j = an - dn - 1; j >= 0; j--)
        {
-         if ((Data->Length + 1) > Data->Size)
+          /* a[j + dn] can't be larger than top, as a[j + 1 .. j + dn] < d. */
+         if (a[j + dn] == top)
           {
-            newData = new Unit [Data->Length + 1];
-
-            std::memcpy(newData, Data->Data, Data->Length * sizeof(Unit));
+            qhat = mask;
+            rhat = a[j + dn - 1] + top;
+            overflow = (rhat < top);
+          }
+         else
+          {
+            unsigned NEXT_TYPE num =
+               ((unsigned NEXT_TYPE)a[j + dn] << BitField::bits) | a[j + dn - 1];
+            qhat = (Unit)(num / top);
+            rhat = (Unit)(num % top);
+            overflow = false;
+          }
 
-            delete [] Data->Data;
-            Data->Data = newData;
-            newData = NULL;
+         while (!overflow && ((unsigned NEXT_TYPE)qhat * secd >
+            (((unsigned NEXT_TYPE)rhat << BitField::bits) | a[j + dn - 2])))
+          {
+            qhat--;
+            rhat += top;
+            overflow = (rhat < top);
+          }
 
-            Data->Size++;
+         if (a[j + dn] < subMulUnit(a + j, d, dn, qhat))
+          {
+            qhat--;
+            addInto(a + j, dn, d, dn); // The carry out cancels the borrow.
           }
+         a[j + dn] = 0;
 
-         Data->Data[Data->Length] = carry;
-         Data->Length++;
+         q[j] = qhat;
        }
     }
 
+   static void divThreeByTwo (Unit *, Unit *, const Unit *, long);
 
+    /*
+      Divide the 2n Units of a by the n Units of d. This only recurses when
+      n is even, which BitField::operator /= arranges by padding the divisor.
+    */
+   static void divTwoByOne (Unit * q, Unit * a, const Unit * d, long n)
+    {
+      if ((n < DivCutoff) || (n & 1))
+       {
+         divSchool(q, a, 2 * n, d, n);
+         return;
+       }
 
-   void BitField::operator *= (Unit mult)
+      long h = n / 2;
+      divThreeByTwo(q + h, a + h, d, h);
+      divThreeByTwo(q, a, d, h);
+    }
+
+    /*
+      Divide the 3h Units of a by the 2h Units of d, making h Units of
+      quotient. The guess from dividing the top 2h Units of a by the top h
+      Units of d is at most two too large.
+    */
+   static void divThreeByTwo (Unit * q, Unit * a, const Unit * d, long h)
     {
-      if (Zero || (mult == 1)) return; // Simple cases 1 + 2
-       // 1: 0 * x = 0
-       // 2: x * 1 = x
+      const Unit * d1 = d + h;
+      const Unit one = 1;
+      Unit * t = new Unit [2 * h];
+      long over = 0;
 
-      if (mult == 0) // Simple case 3: x * 0 = 0
+      if (compareUnits(a + 2 * h, d1, h) < 0)
        {
-         if (!Zero)
-          {
-            Data->Refs--;
-            if (Data->Refs == 0) delete Data;
+         divTwoByOne(q, a + h, d1, h);
+       }
+      else
+       {
+          /*
+            The top of a equals d1. Guess all ones, and then the first
+            remainder is a1 + d1, which may carry.
+          */
+         for (long i = 0; i < h; i++) q[i] = mask;
+         over = (long)addInto(a + h, h, d1, h);
+         std::memset(a + 2 * h, '\0', h * sizeof(Unit));
+       }
 
-            Data = NULL;
-            Zero = true;
-          }
-         return;
+      mulUnits(t, q, h, d, h);
+      over -= (long)subFrom(a, 2 * h, t, 2 * h);
+      while (over < 0)
+       {
+         subFrom(q, h, &one, 1);
+         over += (long)addInto(a, 2 * h, d, 2 * h);
        }
 
-      Unit carry = 0, temp, * newData = NULL;
+      delete [] t;
+    }
+
+    /* The general case: an - dn Units of quotient. */
+   static void divUnits (Unit * q, Unit * a, long an, const Unit * d, long dn)
+    {
+      long qn = an - dn;
 
-      if (Data->Refs != 1)
+      if ((dn < DivCutoff) || (qn < DivCutoff))
        {
-         Data->Refs--;
-         Data = new BitHolder (*Data, 1);
+         divSchool(q, a, an, d, dn);
+         return;
        }
 
-      for (long i = 0; i < Data->Length; i++)
+       /* Take dn Units of quotient at a time, from the top. */
+      while (qn >= dn)
        {
-         temp = Data->Data[i];
-         Data->Data[i] =
-            (Unit)((((unsigned NEXT_TYPE)temp * mult) + carry) & mask);
-         carry =
-            (Unit)((((unsigned NEXT_TYPE)temp * mult) + carry) >> bits);
+         qn -= dn;
+         divTwoByOne(q + qn, a + qn, d, dn);
        }
 
-      if (carry != 0)
+      if (qn == 0) return;
+
+      if (qn < DivCutoff)
        {
-         if ((Data->Length + 1) > Data->Size)
-          {
-            newData = new Unit [Data->Length + 1];
+         divSchool(q, a, qn + dn, d, dn);
+         return;
+       }
 
-            std::memcpy(newData, Data->Data, Data->Length * sizeof(Unit));
+       /*
+         Pad what is left with leading zeros to a full block, rather than
+         write another algorithm for the short end.
+       */
+      Unit * t = new Unit [3 * dn];
 
-            delete [] Data->Data;
-            Data->Data = newData;
-            newData = NULL;
+      std::memcpy(t, a, (qn + dn) * sizeof(Unit));
+      std::memset(t + qn + dn, '\0', (dn - qn) * sizeof(Unit));
 
-            Data->Size++;
-          }
+      divTwoByOne(t + 2 * dn, t, d, dn);
 
-         Data->Data[Data->Length] = carry;
-         Data->Length++;
-       }
+      std::memcpy(q, t + 2 * dn, qn * sizeof(Unit));
+      std::memcpy(a, t, dn * sizeof(Unit));
+      std::memset(a + dn, '\0', qn * sizeof(Unit));
+
+      delete [] t;
     }
 
     /*
-      This is a little wierd. We do the division, mutating the BitField,
-      and return the remainder. This convention makes perfect sense in
-      Integer::toString().
+      this = this / rhs, returns this % rhs. Division by zero is the
+      caller's problem.
     */
-   Unit BitField::operator /= (Unit divisor)
+   BitField BitField::operator /= (const BitField & rhs)
     {
-      if (Zero) return 0; // There's really no good behavior for this.
-       // Throwing exceptions is NOT good behavior.
+      BitField remainder;
 
-      Unit rem = 0, temp;
+      if (Zero) return remainder;
 
-      if (Data->Refs != 1)
+      if (rhs.Data->Length == 1)
        {
-         Data->Refs--;
-         Data = new BitHolder (*Data);
+         remainder = BitField(operator /= (rhs.Data->Data[0]));
+         return remainder;
        }
 
-      for (long i = Data->Length - 1; i >= 0; i--)
+      if (compare(rhs) < 0)
        {
-         temp = Data->Data[i];
-         Data->Data[i] =
-            (Unit)((((unsigned NEXT_TYPE)rem << bits) | temp) / divisor);
-         rem =
-            (Unit)((((unsigned NEXT_TYPE)rem << bits) | temp) % divisor);
+         remainder = *this;
+         release();
+         return remainder;
        }
 
-      if (Data->Data[Data->Length - 1] == 0)
+      long an = Data->Length, dn = rhs.Data->Length, pad = 0, i;
+      int shift = (int)(bits - 1 - rhs.msb() % bits);
+      Unit * a, * d;
+
+       /*
+         The recursive algorithm wants a divisor that is a small number of
+         Units times a power of two. Appending zero Units to both numbers
+         doesn't change the quotient.
+       */
+      if ((dn >= DivCutoff) && (an + 1 - dn >= DivCutoff))
        {
-         Data->Length--;
-         if (Data->Length == 0)
+         long blocks = dn, scale = 1;
+         while (blocks >= DivCutoff)
           {
-            delete Data;
-
-            Data = NULL;
-            Zero = true;
+            blocks = (blocks + 1) / 2;
+            scale *= 2;
           }
+         pad = blocks * scale - dn;
        }
 
-      return rem;
+       /* The extra Unit on a keeps its top dn Units less than d. */
+      a = new Unit [pad + an + 1];
+      d = new Unit [pad + dn];
+      std::memset(a, '\0', pad * sizeof(Unit));
+      std::memset(d, '\0', pad * sizeof(Unit));
+      a[pad + an] = shiftUnitsLeft(a + pad, Data->Data, an, shift);
+      shiftUnitsLeft(d + pad, rhs.Data->Data, dn, shift);
+
+      BitField quotient;
+      long length = an + 1 - dn;
+
+      quotient.allocate(length);
+
+      divUnits(quotient.Data->Data, a, pad + an + 1, d, pad + dn);
+
+      while (quotient.Data->Data[length - 1] == 0) length--;
+      quotient.Data->Length = length;
+
+       /* The remainder is in a, but still shifted. */
+      shiftUnitsRight(a + pad, a + pad, dn, shift);
+      for (i = dn; (i > 0) && (a[pad + i - 1] == 0); i--) ;
+      if (i > 0)
+       {
+         remainder.allocate(i);
+         std::memcpy(remainder.Data->Data, a + pad, i * sizeof(Unit));
+       }
+
+      delete [] a;
+      delete [] d;
+
+       /* rhs may be this, so don't let go of our Data until now. */
+      release();
+      share(quotient);
+
+      return remainder;
     }
 
 
@@ -635,53 +2070,4 @@ namespace BigInt
 
 
 
-    /*
-      This is here because Integer::divmod has no idea what NEXT_TYPE is.
-      shortGuess handles a strange bug in division: see division code.
-
-      From Knuth, TAOCP vol. 2:
-         approx is at most off by 2
-         tempering will solve ALL instances off by 1 and most off by 2
-    */
-   Unit BitField::divApprox (Unit divisor, Unit sec, bool shortGuess) const
-    {
-      if (Zero) return 0;
-
-      Unit approx;
-      unsigned NEXT_TYPE lhs, rhs, temp;
-
-       /*
-         Handle the need for a leading zero.
-         Risk generating a leading zero to ensure that a leading 1 isn't
-         dropped.
-       */
-      if (shortGuess)
-       {
-         approx = Data->Data[Data->Length - 1] / divisor;
-         temp = approx;
-
-         rhs = (((unsigned NEXT_TYPE)Data->Data[Data->Length - 1] %
-            divisor) << bits) | Data->Data[Data->Length - 2];
-       }
-      else
-       {
-         temp = (((unsigned NEXT_TYPE)Data->Data[Data->Length - 1] << bits) |
-            Data->Data[Data->Length - 2]) / divisor;
-         approx = (Unit)temp;
-
-         rhs = (((((unsigned NEXT_TYPE)Data->Data[Data->Length - 1] << bits) |
-            Data->Data[Data->Length - 2]) % divisor) << bits) |
-            Data->Data[Data->Length - 3];
-       }
-
-      lhs = (unsigned NEXT_TYPE)approx * sec;
-
-      if (approx != temp) approx = ((Unit)-1);
-      else if (lhs > rhs) approx--;
-
-      return approx;
-    }
-
-
-
  } /* namespace BigInt */
@@ -51,6 +51,7 @@ SUCH DAMAGE.
 #ifndef BITFIELD_HPP
 #define BITFIELD_HPP
 
+#include <cstddef>
 #ifndef BIG_INT_QUAD_BYTE
  #include <cstdint>
 #endif /* ! BIG_INT_QUAD_BYTE */
@@ -78,18 +79,42 @@ namespace BigInt
                mutable long Refs;
 
                BitHolder ();
+               BitHolder (Unit *, long);
                BitHolder (const BitHolder &, long extra = 0);
                ~BitHolder ();
+
+               static void * operator new (std::size_t);
+               static void operator delete (void *);
           };
 
          BitHolder * Data;
          bool Zero;
 
+          /*
+            Most numbers are small: counters, exponents, single digits.
+            Rather than put them on the heap, Data points to Local, which
+            holds them in Inline. Local is never shared: copies of a small
+            number copy the Units. Data moves to the heap when a number
+            outgrows Inline.
+          */
+         static const long InlineUnits = 4;
+
+         BitHolder Local;
+         Unit Inline [InlineUnits];
+
+         void allocate (long);
+         void release (void);
+         void share (const BitField &);
+         void take (BitField &);
+         void own (long extra = 0);
+         void reserve (long);
+
       public:
 
          BitField ();
          BitField (Unit);
          BitField (const BitField &);
+         BitField (BitField &&);
 
          ~BitField ();
 
@@ -104,7 +129,11 @@ namespace BigInt
          void operator *= (Unit);
          Unit operator /= (Unit);
 
+         void operator *= (const BitField &);
+         BitField operator /= (const BitField &);
+
          void operator = (const BitField &);
+         void operator = (BitField &&);
 
          bool isZero (void) const
           { return Zero; }
@@ -116,12 +145,17 @@ namespace BigInt
 
          Unit getDigit (long) const;
 
-         Unit divApprox (Unit, Unit, bool) const;
-
          int compare (const BitField &) const;
 
          const static int bits;
 
+          /*
+            Holders and Unit arrays come from a pool. These are its hit and
+            miss counts for this thread and every thread that has exited.
+          */
+         static void poolStatistics (unsigned long & hits,
+                                     unsigned long & misses);
+
     }; /* class BitField */
 
  } /* namespace BigInt */
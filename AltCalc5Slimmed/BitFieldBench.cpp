@@ -0,0 +1,124 @@
+/*
+Copyright (c) 2013 Thomas DiModica.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+3. Neither the name of Thomas DiModica nor the names of other contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THOMAS DIMODICA AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THOMAS DIMODICA OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+SUCH DAMAGE.
+*/
+
+/*
+   Times the BitField kernels, in nanoseconds per Unit. BitFieldBench.sh
+   builds this twice: once as is, and once with BIG_INT_PORTABLE, for the
+   plain C++ loops to compare against.
+*/
+#include <chrono>
+#include <cstdio>
+
+#include "BitField.hpp"
+
+using namespace BigInt;
+
+typedef std::chrono::steady_clock Clock;
+
+static const long Length = 1000;
+static const long Rows = 24; // Below KaratsubaCutoff, so all schoolbook
+static const long Trials = 20000;
+
+static unsigned long long state = 88172645463325252ULL;
+
+static Unit random (void)
+ {
+   state ^= state << 13;
+   state ^= state >> 7;
+   state ^= state << 17;
+   return (Unit)state;
+ }
+
+static BitField randomField (long units)
+ {
+   BitField result;
+   for (long i = 0; i < units; i++)
+    {
+      result <<= BitField::bits;
+      result += random();
+    }
+   return result;
+ }
+
+static double elapsed (Clock::duration time, long units)
+ {
+   return std::chrono::duration<double, std::nano>(time).count() /
+      ((double)Trials * (double)units);
+ }
+
+int main (void)
+ {
+   BitField x = randomField(Length), y = randomField(Length - 1);
+   Clock::duration add (0), sub (0), mul (0), div (0), row (0);
+   Clock::time_point start;
+   Unit m = 1000000007, check = 0;
+
+   for (long i = 0; i < Trials; i++)
+    {
+      start = Clock::now();
+      x += y;
+      add += Clock::now() - start;
+
+      start = Clock::now();
+      x -= y;
+      sub += Clock::now() - start;
+
+      start = Clock::now();
+      x *= m;
+      mul += Clock::now() - start;
+
+      start = Clock::now();
+      check += (x /= m);
+      div += Clock::now() - start;
+    }
+
+   BitField a = randomField(Rows), b = randomField(Rows);
+   for (long i = 0; i < Trials; i++)
+    {
+      BitField p (a);
+      start = Clock::now();
+      p *= b;
+      row += Clock::now() - start;
+      check += p.getDigit(Rows);
+    }
+
+#ifdef BIG_INT_PORTABLE
+   std::printf("Portable kernels\n");
+#else
+   std::printf("Default kernels\n");
+#endif
+   std::printf("  += BitField  %6.3f ns/Unit\n", elapsed(add, Length));
+   std::printf("  -= BitField  %6.3f ns/Unit\n", elapsed(sub, Length));
+   std::printf("  *= Unit      %6.3f ns/Unit\n", elapsed(mul, Length));
+   std::printf("  /= Unit      %6.3f ns/Unit\n", elapsed(div, Length));
+   std::printf("  *= BitField  %6.3f ns/Unit^2 (%ld x %ld)\n",
+      elapsed(row, Rows * Rows), Rows, Rows);
+
+   return (check == 1) ? 1 : 0; // Keeps the work from being optimized away
+ }
@@ -0,0 +1,2 @@
+g++ -O2 -Wall -Wextra -Wpedantic -Wconversion -o BitFieldBench BitFieldBench.cpp BitField.cpp
+g++ -O2 -Wall -Wextra -Wpedantic -Wconversion -DBIG_INT_PORTABLE -o BitFieldBenchPortable BitFieldBench.cpp BitField.cpp
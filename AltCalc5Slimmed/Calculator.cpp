@@ -161,7 +161,7 @@ void Calculator::doStuff (string doThis)
    else if (doThis == "sqr")
     {
       left = stacks[currentStack].top(); stacks[currentStack].pop();
-      stacks[currentStack].push(left * left);
+      stacks[currentStack].push(sqr(left));
     }
    else if (doThis == "shorten")
     {
@@ -19,6 +19,7 @@
 /*
    File: Constants.cpp
 */
+#include <cstddef>
 #include "Constants.hpp"
 
 namespace BigInt
@@ -141,4 +142,224 @@ namespace BigInt
 "989490946942185000735834884464388273110928910904234805423565E-1"
       );
 
+
+    /*
+      Constants past the tables are summed as series by binary splitting:
+      for the terms a to b - 1 of
+         sum a(n) / b(n) * (p(0) * ... * p(n)) / (q(0) * ... * q(n))
+      split finds the products P, Q and B of the p's, q's and b's, and a T
+      such that the sum is T / (B * Q). Two halves are put together as
+         P = P1 * P2,   Q = Q1 * Q2,   B = B1 * B2,
+         T = B2 * Q2 * T1 + B1 * P1 * T2
+      and the only division is at the very end.
+
+      pi is from the Chudnovskys' series, which gives about fourteen digits
+      a term, and ln(2) is from Machin-like formulas for atanh:
+         ln(2) = 18 atanh(1/26) - 2 atanh(1/4801) + 8 atanh(1/8749)
+      and ln(10) = ln(1.25) + 3 ln(2) = 2 atanh(1/9) + 3 ln(2).
+
+      The Integer reference counts are not atomic, so each thread keeps
+      its own constants, as with the powers of ten in Fixed.cpp.
+
+      A constant is worked out, or rounded from its table, to ConstantExtra
+      more digits than asked for, in ROUND_TIES_EVEN, and is then good to
+      ConstantError units in its last place. None of these constants has
+      an exact decimal expansion, so if the extra digits are further than
+      that from all zeros, all nines or a half, the true value is past the
+      same digits, and rounding the guarded value once, in the caller's
+      mode, rounds it the same way. Otherwise it is done again with twice
+      as many extra digits.
+    */
+   const static unsigned long ConstantExtra = 10;
+   const static long ConstantError = 100;
+
+   static const Float * const tables [CONSTANTS] =
+    {
+      NULL, &M_LN10, &M_PI, &M_PI_2, &M_PI_4, &M_2PI, &M_1_2PI, &M_1_SQRT10
+    };
+
+   static thread_local Float cache [CONSTANTS];
+
+   struct Split
+    {
+      Integer P, Q, B, T;
+    };
+
+   typedef void (*Term) (Split &, long n, long k);
+
+    /* 640320 ^ 3 / 24 won't fit in 32 bits. */
+   static void chudnovskyTerm (Split & term, long n, long)
+    {
+      if (n == 0)
+       {
+         term.P = Integer(1);
+         term.Q = Integer(1);
+       }
+      else
+       {
+         term.P = -(Integer(6 * n - 5) * Integer(2 * n - 1) *
+                    Integer(6 * n - 1));
+         term.Q = Integer(n) * Integer(n) * Integer(n) * Integer(26680) *
+                  Integer(640320) * Integer(640320);
+       }
+      term.B = Integer(1);
+      term.T = term.P * (Integer(545140134) * Integer(n) +
+                         Integer(13591409));
+    }
+
+    /* atanh(1 / k), without the division by 1 - 1 / k ^ 2. */
+   static void atanhTerm (Split & term, long n, long k)
+    {
+      term.P = Integer(1);
+      term.Q = (n == 0) ? Integer(k) : Integer(k) * Integer(k);
+      term.B = Integer(2 * n + 1);
+      term.T = term.P;
+    }
+
+   static void split (Split & res, Term term, long k, long a, long b)
+    {
+      if (b - a == 1)
+       {
+         term(res, a, k);
+         return;
+       }
+
+      Split right;
+      long mid = (a + b) / 2;
+
+      split(res, term, k, a, mid);
+      split(right, term, k, mid, b);
+
+      res.T = right.B * right.Q * res.T + res.B * res.P * right.T;
+      res.P *= right.P;
+      res.Q *= right.Q;
+      res.B *= right.B;
+    }
+
+   static Float chudnovsky (unsigned long digits)
+    {
+      Split sum;
+
+      split(sum, chudnovskyTerm, 0, 0, (long)(digits / 14) + 2);
+
+      return Float(Integer(426880), 0, digits) *
+             sqrt(Float(Integer(10005), 0, digits)) *
+             Float(sum.B * sum.Q, 0, digits) / Float(sum.T, 0, digits);
+    }
+
+   static Float atanhInverse (long k, unsigned long digits)
+    {
+      double scale = 1.0; // k ^ (2n) is about scale * 10 ^ size.
+      long size = 0, n = 0;
+      Split sum;
+
+      while (size < (long)digits)
+       {
+         n++;
+         scale *= (double)k * (double)k;
+         while (scale >= 10.0)
+          {
+            scale /= 10.0;
+            size++;
+          }
+       }
+
+      split(sum, atanhTerm, k, 0, n + 1);
+
+      return Float(sum.T, 0, digits) /
+             (Float(sum.B, 0, digits) * Float(sum.Q, 0, digits));
+    }
+
+   static Float generate (Constant which, unsigned long digits)
+    {
+      Float one (Integer(1), 0, digits), res;
+
+      switch (which)
+       {
+         case CONST_LN2:
+            res = Float(Integer(18), 0, digits) * atanhInverse(26, digits) -
+                  Float(Integer(2), 0, digits) * atanhInverse(4801, digits) +
+                  Float(Integer(8), 0, digits) * atanhInverse(8749, digits);
+            break;
+         case CONST_LN10:
+            res = Float(Integer(2), 0, digits) * atanhInverse(9, digits) +
+                  Float(Integer(3), 0, digits) * constant(CONST_LN2, digits);
+            break;
+         case CONST_PI:
+            res = chudnovsky(digits);
+            break;
+         case CONST_PI_2:
+            res = constant(CONST_PI, digits) / Float(Integer(2), 0, digits);
+            break;
+         case CONST_PI_4:
+            res = constant(CONST_PI, digits) / Float(Integer(4), 0, digits);
+            break;
+         case CONST_2PI:
+            res = constant(CONST_PI, digits);
+            res += res;
+            break;
+         case CONST_1_2PI:
+            res = one / constant(CONST_2PI, digits);
+            break;
+         case CONST_1_SQRT10:
+            res = one / sqrt(Float(Integer(10), 0, digits));
+            break;
+         case CONSTANTS:
+            break;
+       }
+
+      return res;
+    }
+
+   static Float guarded (Constant which, unsigned long digits)
+    {
+      Float res;
+      Fixed_Round_Mode mode = Fixed::getRoundMode();
+
+      Fixed::setRoundMode(ROUND_TIES_EVEN);
+      if ((tables[which] != NULL) && (tables[which]->getPrecision() >= digits))
+         res = *tables[which];
+      else
+       {
+         if (cache[which].isZero() || (cache[which].getPrecision() < digits))
+            cache[which] = generate(which, digits);
+         res = cache[which];
+       }
+      res.setPrecision(digits);
+      Fixed::setRoundMode(mode);
+
+      return res;
+    }
+
+    /* Are the digits of x past precision clear of where rounding changes? */
+   static bool clearOfBoundaries (const Float & x, unsigned long precision,
+                                  unsigned long digits)
+    {
+      Integer tail (x.toInteger(x.exponent() - (long)digits)), high;
+      Integer scale (Fixed::powerOfTen(digits - precision));
+      Integer error (ConstantError), half;
+
+      Integer::divmod(scale, Integer(2), half, high);
+      tail.abs();
+      Integer::divmod(tail, scale, high, tail);
+
+      return (tail.compare(error) > 0) &&
+             ((scale - tail).compare(error) > 0) &&
+             ((tail - half).abs().compare(error) > 0);
+    }
+
+   Float constant (Constant which, unsigned long precision)
+    {
+      Float res;
+
+      for (unsigned long extra = ConstantExtra; ; extra *= 2)
+       {
+         res = guarded(which, precision + extra);
+         if (clearOfBoundaries(res, precision, precision + extra)) break;
+       }
+
+      res.setPrecision(precision);
+      return res;
+    }
+
  } //namespace BigInt
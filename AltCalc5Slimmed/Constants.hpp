@@ -48,6 +48,20 @@ namespace BigInt
 
    extern const Float M_1_SQRT10;
 
+    /*
+      The constants above have about six hundred digits. These are the
+      same constants to any precision: they are worked out the first time
+      a precision beyond the tables is asked for, and kept, so asking
+      again, for that many digits or fewer, only rounds the kept value.
+    */
+   enum Constant
+    {
+      CONST_LN2, CONST_LN10, CONST_PI, CONST_PI_2, CONST_PI_4, CONST_2PI,
+      CONST_1_2PI, CONST_1_SQRT10, CONSTANTS
+    };
+
+   Float constant (Constant which, unsigned long precision);
+
  } //namespace BigInt
 
 #endif /* CONSTANTS_HPP */
@@ -29,6 +29,8 @@ SUCH DAMAGE.
 
 #include <cstdlib>
 #include <string>
+#include <utility>
+#include <vector>
 #include "Fixed.hpp"
 
 #ifndef SEPERATOR
@@ -39,6 +41,46 @@ namespace BigInt
  {
 
 
+    /*
+      Nearly every Fixed operation rescales by a power of ten, so they are
+      kept instead of being recomputed with pow() every time. 10^n for n
+      below DensePowers is in densePowers[n], and is filled in on demand.
+      Bigger powers are put together from a dense power and the blocks
+      10^(DensePowers * 2^k), which are squared up as they are needed.
+
+      The Integer reference counts are not atomic, so threads can't share
+      one Integer. Instead, each thread gets its own cache.
+    */
+   const static unsigned long DensePowers = 1024;
+
+   static thread_local std::vector<Integer> densePowers, blockPowers;
+
+   Integer Fixed::powerOfTen (unsigned long n)
+    {
+      if (densePowers.empty()) densePowers.push_back(Integer(1));
+
+      unsigned long dense = n % DensePowers, blocks = n / DensePowers;
+      while (densePowers.size() <= ((blocks == 0) ? dense : DensePowers - 1))
+         densePowers.push_back(densePowers.back() * Integer(10));
+
+      Integer result (densePowers[dense]);
+
+      for (unsigned long k = 0; blocks != 0; blocks >>= 1, k++)
+       {
+         if (blockPowers.size() <= k)
+          {
+            if (k == 0)
+               blockPowers.push_back(densePowers.back() * Integer(10));
+            else
+               blockPowers.push_back(sqr(blockPowers[k - 1]));
+          }
+         if (blocks & 1) result *= blockPowers[k];
+       }
+
+      return result;
+    }
+
+
    unsigned long Fixed::defPrec = 7;
 
    Fixed_Round_Mode Fixed::mode = ROUND_TIES_EVEN;
@@ -64,6 +106,15 @@ namespace BigInt
       return *this;
     }
 
+   Fixed & Fixed::operator = (Fixed && src)
+    {
+      if (&src == this) return *this;
+      Data = std::move(src.Data);
+      Digits = src.Digits;
+      sticky = src.sticky;
+      return *this;
+    }
+
 
    void match (Fixed & lhs, Fixed & rhs)
     {
@@ -95,91 +146,127 @@ namespace BigInt
     }
 
 
+    /*
+      The operators work on a copy of lhs, so the rvalue versions do the
+      real work, in place in lhs.
+    */
    Fixed operator + (const Fixed & lhs, const Fixed & rhs)
     {
-      Fixed temp;
+      return Fixed(lhs) + rhs;
+    }
 
+   Fixed operator + (Fixed && lhs, const Fixed & rhs)
+    {
       if (lhs.Digits > rhs.Digits)
        {
-         temp = rhs;
+         Fixed temp (rhs);
          temp.changePrecision(lhs.Digits);
-         temp.Data += lhs.Data;
-       }
-      else if (lhs.Digits < rhs.Digits)
-       {
-         temp = lhs;
-         temp.changePrecision(rhs.Digits);
-         temp.Data += rhs.Data;
+         lhs.Data += temp.Data;
        }
       else
        {
-         temp.Data = lhs.Data + rhs.Data;
-         temp.Digits = lhs.Digits;
+         if (lhs.Digits < rhs.Digits) lhs.changePrecision(rhs.Digits);
+         lhs.Data += rhs.Data;
        }
 
-      return temp;
+      return std::move(lhs);
     }
 
    Fixed operator - (const Fixed & lhs, const Fixed & rhs)
     {
-      Fixed temp1 (lhs), temp2 (rhs);
-      match(temp1, temp2);
+      return Fixed(lhs) - rhs;
+    }
 
-      temp1.Data -= temp2.Data;
+   Fixed operator - (Fixed && lhs, const Fixed & rhs)
+    {
+      if (lhs.Digits > rhs.Digits)
+       {
+         Fixed temp (rhs);
+         temp.changePrecision(lhs.Digits);
+         lhs.Data -= temp.Data;
+       }
+      else
+       {
+         if (lhs.Digits < rhs.Digits) lhs.changePrecision(rhs.Digits);
+         lhs.Data -= rhs.Data;
+       }
 
-      return temp1;
+      return std::move(lhs);
     }
 
    Fixed operator * (const Fixed & lhs, const Fixed & rhs)
     {
-      Fixed temp (lhs);
+      return Fixed(lhs) * rhs;
+    }
 
+   Fixed operator * (Fixed && lhs, const Fixed & rhs)
+    {
+      lhs.multiply(rhs);
+      return std::move(lhs);
+    }
+
+    /*
+      this = this * rhs, with the precision of the more precise of the two.
+      rhs may be this, and then Integer squares instead.
+    */
+   void Fixed::multiply (const Fixed & rhs)
+    {
       unsigned long resDigits;
-      if (lhs.Digits > rhs.Digits)
-         resDigits = lhs.Digits;
+      if (Digits > rhs.Digits)
+         resDigits = Digits;
       else
          resDigits = rhs.Digits;
 
-      temp.Data *= rhs.Data;
-      temp.Digits += rhs.Digits;
+      Data *= rhs.Data;
+      Digits += rhs.Digits;
 
       Fixed top (10, 0);
-      if (temp.compare(top) >= 0)
+      if (compare(top) >= 0)
        {
-         temp.changePrecision(resDigits - 1);
-         temp.sticky = true;
+         changePrecision(resDigits - 1);
+         sticky = true;
        }
       else
        {
-         temp.changePrecision(resDigits);
+         changePrecision(resDigits);
             //Did we round up to 10?
-         if (temp.compare(top) >= 0)
+         if (compare(top) >= 0)
           {
                //The removed digit will always be zero.
-            temp.changePrecision(resDigits - 1);
-            temp.sticky = true;
+            changePrecision(resDigits - 1);
+            sticky = true;
           }
        }
+    }
 
-      return temp;
+   Fixed sqr (const Fixed & arg)
+    {
+      Fixed result (arg);
+      result.square();
+      return result;
     }
 
    Fixed operator / (const Fixed & lhs, const Fixed & rhs)
     {
-      Fixed q = lhs;
+      return Fixed(lhs) / rhs;
+    }
+
+   Fixed operator / (Fixed && lhs, const Fixed & rhs)
+    {
       Fixed r = rhs;
       Integer d;
       bool s = lhs.Data.isSigned() ^ rhs.Data.isSigned();
       int oneExtra = (rhs.compare(lhs) > 0) ? 1 : 0;
+      Fixed q (std::move(lhs));
 
-      if (lhs.Digits > rhs.Digits)
+      if (q.Digits > rhs.Digits)
        {
-         q.Data *= pow(Integer(10), Integer((long) (r.Digits + oneExtra)));
-         q.Digits = lhs.Digits + oneExtra;
+         q.Data *= Fixed::powerOfTen(r.Digits + oneExtra);
+         q.Digits += oneExtra;
        }
       else
        {
-         q.Data *= pow(Integer(10), Integer((long) (2 * r.Digits - q.Digits + oneExtra)));
+         q.Data *= Fixed::powerOfTen(2 * r.Digits - q.Digits + oneExtra);
          q.Digits = rhs.Digits + oneExtra;
        }
 
@@ -211,12 +298,12 @@ namespace BigInt
       if (newPrec == Digits) return;
       if (newPrec > Digits)
        {
-         scale = pow(Integer(10), Integer((long) (newPrec - Digits)));
+         scale = powerOfTen(newPrec - Digits);
          Data *= scale;
        }
       else
        {
-         scale = pow(Integer(10), Integer((long) (Digits - newPrec)));
+         scale = powerOfTen(Digits - newPrec);
          Integer::divmod(Data, scale, Data, rem);
 
          rem *= Integer(2);
@@ -239,7 +326,7 @@ namespace BigInt
       if (Digits == 0) return result;
       if (result.length() <= Digits)
        {
-         while (result.length() < Digits) result = '0' + result;
+         result = std::string(Digits - result.length(), '0') + result;
          result = '0' + (SEPERATOR + result);
        }
       else
@@ -336,7 +423,7 @@ namespace BigInt
     {
       Integer temp, scale;
 
-      scale = pow(Integer(10), Integer((long) (Digits)));
+      scale = powerOfTen(Digits);
       Integer::divmod(Data, scale, temp, scale);
 
       return scale.isZero();
@@ -346,7 +433,7 @@ namespace BigInt
     {
       Integer temp, scale;
 
-      scale = pow(Integer(10), Integer((long) (Digits)));
+      scale = powerOfTen(Digits);
       Integer::divmod(Data, scale, temp, scale);
 
       return scale.isZero() ? temp.isOdd() : false;
@@ -356,7 +443,7 @@ namespace BigInt
     {
       Integer temp, scale;
 
-      scale = pow(Integer(10), Integer((long) (Digits)));
+      scale = powerOfTen(Digits);
       Integer::divmod(Data, scale, temp, scale);
 
       return scale.isZero() ? temp.isEven() : false;
@@ -30,6 +30,7 @@ SUCH DAMAGE.
 #ifndef FIXED_HPP
 #define FIXED_HPP
 
+#include <utility>
 #include "Integer.hpp"
 
 namespace BigInt
@@ -55,7 +56,7 @@ namespace BigInt
          static unsigned long defPrec;
          static Fixed_Round_Mode mode;
 
-         static bool decideRound (bool, bool, int, bool);
+         void multiply (const Fixed &);
 
       public:
          static unsigned long getDefaultPrecision (void) { return defPrec; }
@@ -66,6 +67,14 @@ namespace BigInt
          static Fixed_Round_Mode setRoundMode (Fixed_Round_Mode newMode)
           { return (mode = newMode); }
 
+            //Whether to bump a truncated value away from zero: takes the
+            //sign, if the truncated value is even, half the removed scale
+            //compared with the removed digits, and if they were zero.
+         static bool decideRound (bool, bool, int, bool);
+
+            //10 ^ n, from a cache of the powers kept by each thread.
+         static Integer powerOfTen (unsigned long);
+
       private:
          Integer Data;
          unsigned long Digits;
@@ -75,10 +84,15 @@ namespace BigInt
 
          Fixed (const Fixed & from) :
             Data (from.Data), Digits (from.Digits), sticky(from.sticky) { }
+         Fixed (Fixed && from) :
+            Data (std::move(from.Data)), Digits (from.Digits),
+            sticky(from.sticky) { }
          Fixed (unsigned long precision = defPrec) :
             Data (), Digits (precision), sticky(false) { }
          Fixed (long i, unsigned long p = defPrec) :
             Data (i), Digits (p), sticky(false) { }
+         Fixed (const Integer & i, unsigned long p = defPrec) :
+            Data (i), Digits (p), sticky(false) { }
          Fixed (const std::string &);
          Fixed (const char *);
          ~Fixed () { /* This has nothing to do. */ }
@@ -94,6 +108,16 @@ namespace BigInt
 
          bool isSigned (void) const { return Data.isSigned(); }
          bool isZero (void) const { return Data.isZero(); }
+         long msb (void) const { return Data.msb(); } //of the scaled Integer
+
+            //The scaled Integer, if it is not negative and fits in a Unit.
+         bool toUnit (Unit & to) const
+          {
+            if (Data.isSigned() || (Data.msb() >= (long)(8 * sizeof(Unit))))
+               return false;
+            to = Data.getDigit(0);
+            return true;
+          }
 
          bool isInteger (void) const;
          bool isOdd (void) const;
@@ -112,12 +136,15 @@ namespace BigInt
          Fixed & setSign (bool toThis)
             { Data.setSign(toThis); return *this; }
 
-         friend Fixed operator + (const Fixed &, const Fixed &);
-         friend Fixed operator - (const Fixed &, const Fixed &);
-         friend Fixed operator * (const Fixed &, const Fixed &);
-         friend Fixed operator / (const Fixed &, const Fixed &);
+         friend Fixed operator + (Fixed &&, const Fixed &);
+         friend Fixed operator - (Fixed &&, const Fixed &);
+         friend Fixed operator * (Fixed &&, const Fixed &);
+         friend Fixed operator / (Fixed &&, const Fixed &);
+
+         Fixed & square (void) { multiply(*this); return *this; }
 
          Fixed & operator = (const Fixed &);
+         Fixed & operator = (Fixed &&);
 
          int compare (const Fixed &) const;
 
@@ -128,9 +155,15 @@ namespace BigInt
     }; /* class Fixed */
 
    Fixed operator + (const Fixed &, const Fixed &);
+   Fixed operator + (Fixed &&, const Fixed &);
    Fixed operator - (const Fixed &, const Fixed &);
+   Fixed operator - (Fixed &&, const Fixed &);
    Fixed operator * (const Fixed &, const Fixed &);
+   Fixed operator * (Fixed &&, const Fixed &);
    Fixed operator / (const Fixed &, const Fixed &);
+   Fixed operator / (Fixed &&, const Fixed &);
+
+   Fixed sqr (const Fixed &);
 
    void match (Fixed &, Fixed &);
 
@@ -0,0 +1,771 @@
+/*
+Copyright (c) 2013 Thomas DiModica.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+3. Neither the name of Thomas DiModica nor the names of other contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THOMAS DIMODICA AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THOMAS DIMODICA OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+SUCH DAMAGE.
+*/
+
+#ifndef FIXEDFLOAT_HPP
+#define FIXEDFLOAT_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "Float.hpp"
+
+#ifndef __SIZEOF_INT128__
+ #error "FixedPrecisionFloat needs unsigned __int128."
+#endif
+
+namespace BigInt
+ {
+
+    /*
+      A Float whose precision is fixed when it is compiled. Digits is what
+      getPrecision() would return for a Float, so there are Digits + 1
+      significant digits: FixedPrecisionFloat<33> holds a 34 digit number.
+
+      The significand lives in an array of Limbs words of 18 decimal digits
+      each, least significant first, so nothing is ever allocated, copies
+      are plain copies, and every loop runs a number of times that the
+      compiler knows and can unroll. +, -, * and / are correctly rounded,
+      once, with Fixed's round mode, and agree with Float's operators on
+      Floats of precision Digits, but for three things: * and / here round
+      negative results toward the correct infinity in the directed round
+      modes, ROUND_05_AWAY is applied once where Float can apply it twice,
+      and + and - here still round by an operand too small for Float to
+      add. FixedFloatTest.cpp checks them against exact Integers.
+
+      Everything else, the functions and the conversions to and from
+      strings, goes through Float.
+    */
+   template <unsigned long Digits>
+   class FixedPrecisionFloat
+    {
+
+      private:
+         static_assert(Digits > 0, "A FixedPrecisionFloat needs a digit after the point.");
+
+         __extension__ typedef unsigned __int128 Wide;
+
+         static const unsigned long LimbDigits = 18;
+         static const std::uint64_t Base = 1000000000000000000ULL;
+         static const std::size_t Limbs = (Digits + LimbDigits) / LimbDigits;
+
+         typedef std::array<std::uint64_t, Limbs> Significand;
+         typedef std::array<std::uint64_t, 2 * Limbs + 1> Product;
+
+         Significand Data; //Digits + 1 digits, or all zero
+         bool Sign;
+         long Exponent;
+
+         bool Infinity;
+         long NaN;
+
+
+         static std::uint64_t tenTo (unsigned long power)
+          {
+            static const std::uint64_t table [LimbDigits + 1] =
+             {
+               1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL,
+               1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL,
+               10000000000ULL, 100000000000ULL, 1000000000000ULL,
+               10000000000000ULL, 100000000000000ULL, 1000000000000000ULL,
+               10000000000000000ULL, 100000000000000000ULL,
+               1000000000000000000ULL
+             };
+            return table[power];
+          }
+
+         template <std::size_t N>
+         static bool isZero (const std::array<std::uint64_t, N> & of)
+          {
+            for (std::size_t i = 0; i < N; i++) if (of[i]) return false;
+            return true;
+          }
+
+         template <std::size_t N>
+         static unsigned long countDigits
+            (const std::array<std::uint64_t, N> & of)
+          {
+            std::size_t top = N;
+            while ((top > 0) && (of[top - 1] == 0)) top--;
+            if (top == 0) return 0;
+
+            unsigned long digits = 1;
+            while ((digits < LimbDigits) && (of[top - 1] >= tenTo(digits)))
+               digits++;
+            return (unsigned long)(top - 1) * LimbDigits + digits;
+          }
+
+         template <std::size_t N>
+         static int compare (const std::array<std::uint64_t, N> & lhs,
+                             const std::array<std::uint64_t, N> & rhs)
+          {
+            for (std::size_t i = N; i-- > 0; )
+               if (lhs[i] != rhs[i]) return (lhs[i] > rhs[i]) ? 1 : -1;
+            return 0;
+          }
+
+         template <std::size_t N>
+         static void add (std::array<std::uint64_t, N> & to,
+                          const std::array<std::uint64_t, N> & from)
+          {
+            std::uint64_t carry = 0;
+            for (std::size_t i = 0; i < N; i++)
+             {
+               to[i] += from[i] + carry;
+               carry = (to[i] >= Base) ? 1 : 0;
+               if (carry) to[i] -= Base;
+             }
+          }
+
+            //to must not be less than from.
+         template <std::size_t N>
+         static void subtract (std::array<std::uint64_t, N> & to,
+                               const std::array<std::uint64_t, N> & from)
+          {
+            std::uint64_t borrow = 0;
+            for (std::size_t i = 0; i < N; i++)
+             {
+               std::uint64_t take = from[i] + borrow;
+               borrow = (to[i] < take) ? 1 : 0;
+               to[i] = to[i] + (borrow ? Base : 0) - take;
+             }
+          }
+
+            //True if it carried out of the top limb.
+         template <std::size_t N>
+         static bool increment (std::array<std::uint64_t, N> & of)
+          {
+            for (std::size_t i = 0; i < N; i++)
+             {
+               if (++of[i] < Base) return false;
+               of[i] = 0;
+             }
+            return true;
+          }
+
+            //of *= 10 ^ places, which must fit.
+         template <std::size_t N>
+         static void shiftUp (std::array<std::uint64_t, N> & of,
+                              unsigned long places)
+          {
+            std::size_t limbs = places / LimbDigits;
+            if (limbs)
+               for (std::size_t i = N; i-- > 0; )
+                  of[i] = (i >= limbs) ? of[i - limbs] : 0;
+
+            places %= LimbDigits;
+            if (places == 0) return;
+
+            std::uint64_t scale = tenTo(places), split = Base / scale;
+            std::uint64_t carry = 0;
+            for (std::size_t i = 0; i < N; i++)
+             {
+               std::uint64_t next = of[i] / split;
+               of[i] = (of[i] % split) * scale + carry;
+               carry = next;
+             }
+          }
+
+          /*
+            of /= 10 ^ places, truncated, with what decideRound needs to
+            know about the removed digits: how half of 10 ^ places compares
+            with them, and whether they were all zero.
+          */
+         template <std::size_t N>
+         static void shiftDown (std::array<std::uint64_t, N> & of,
+                                unsigned long places, int & comp, bool & zero)
+          {
+            std::size_t at = (places - 1) / LimbDigits;
+            std::uint64_t below = tenTo((places - 1) % LimbDigits);
+            std::uint64_t lead = (of[at] / below) % 10;
+            bool rest = (of[at] % below) == 0;
+
+            for (std::size_t i = 0; i < at; i++) if (of[i]) rest = false;
+
+            comp = (lead < 5) ? 1 : (((lead == 5) && rest) ? 0 : -1);
+            zero = (lead == 0) && rest;
+
+            std::size_t limbs = places / LimbDigits;
+            if (limbs)
+               for (std::size_t i = 0; i < N; i++)
+                  of[i] = (i + limbs < N) ? of[i + limbs] : 0;
+
+            places %= LimbDigits;
+            if (places == 0) return;
+
+            std::uint64_t scale = tenTo(places), split = Base / scale;
+            std::uint64_t carry = 0;
+            for (std::size_t i = N; i-- > 0; )
+             {
+               std::uint64_t next = of[i] % scale;
+               of[i] = carry * split + of[i] / scale;
+               carry = next;
+             }
+          }
+
+            //Comba's column order: one reduction per column of products.
+         static void multiply (const Significand & lhs, const Significand & rhs,
+                               Product & to)
+          {
+            Wide column = 0;
+            for (std::size_t k = 0; k < 2 * Limbs - 1; k++)
+             {
+               std::size_t first = (k >= Limbs) ? k - Limbs + 1 : 0;
+               std::size_t last = (k < Limbs) ? k : Limbs - 1;
+               for (std::size_t i = first; i <= last; i++)
+                  column += (Wide)lhs[i] * rhs[k - i];
+               to[k] = (std::uint64_t)(column % Base);
+               column /= Base;
+             }
+            to[2 * Limbs - 1] = (std::uint64_t)column;
+            to[2 * Limbs] = 0;
+          }
+
+          /*
+            Knuth's algorithm D in base 10 ^ 18: quotient = from / by, which
+            must fit in a Significand. by must have Digits + 1 digits, so its
+            top limb is never zero. Instead of the remainder, this gives how
+            by compares with twice it, and whether it is zero.
+          */
+         static void divide (Product & from, const Significand & by,
+                             Significand & quotient, int & comp, bool & zero)
+          {
+            const std::size_t n = Limbs;
+            quotient.fill(0);
+
+            if (n == 1)
+             {
+               Wide rem = 0;
+               for (std::size_t i = 2 * Limbs + 1; i-- > 0; )
+                {
+                  Wide part = rem * Base + from[i];
+                  if (i < Limbs) quotient[i] = (std::uint64_t)(part / by[0]);
+                  rem = part % by[0];
+                }
+               rem *= 2;
+               comp = (by[0] > rem) ? 1 : ((by[0] < rem) ? -1 : 0);
+               zero = (rem == 0);
+               return;
+             }
+
+               //Normalize so that the top limb of the divisor is at least
+               //half of Base. The top limb of from is zero, so it fits.
+            std::uint64_t scale = Base / (by[n - 1] + 1);
+            Significand v;
+            std::uint64_t carry = 0;
+            for (std::size_t i = 0; i < n; i++)
+             {
+               Wide part = (Wide)by[i] * scale + carry;
+               v[i] = (std::uint64_t)(part % Base);
+               carry = (std::uint64_t)(part / Base);
+             }
+            carry = 0;
+            for (std::size_t i = 0; i < 2 * Limbs + 1; i++)
+             {
+               Wide part = (Wide)from[i] * scale + carry;
+               from[i] = (std::uint64_t)(part % Base);
+               carry = (std::uint64_t)(part / Base);
+             }
+
+            for (std::size_t j = 2 * Limbs + 1 - n; j-- > 0; )
+             {
+               Wide top = (Wide)from[j + n] * Base + from[j + n - 1];
+               Wide guess = top / v[n - 1], rem = top % v[n - 1];
+
+               while ((guess >= Base) ||
+                      (guess * v[n - 2] > rem * Base + from[j + n - 2]))
+                {
+                  guess--;
+                  rem += v[n - 1];
+                  if (rem >= Base) break;
+                }
+
+               std::uint64_t borrow = 0;
+               for (std::size_t i = 0; i < n; i++)
+                {
+                  Wide part = guess * v[i] + borrow;
+                  std::uint64_t low = (std::uint64_t)(part % Base);
+                  borrow = (std::uint64_t)(part / Base);
+                  if (from[i + j] < low)
+                   {
+                     from[i + j] += Base - low;
+                     borrow++;
+                   }
+                  else
+                     from[i + j] -= low;
+                }
+
+               if (from[j + n] < borrow)
+                {
+                     //Guessed one too many: add the divisor back once.
+                  guess--;
+                  carry = 0;
+                  for (std::size_t i = 0; i < n; i++)
+                   {
+                     from[i + j] += v[i] + carry;
+                     carry = (from[i + j] >= Base) ? 1 : 0;
+                     if (carry) from[i + j] -= Base;
+                   }
+                  from[j + n] = from[j + n] + carry - borrow;
+                }
+               else
+                  from[j + n] -= borrow;
+
+               if (j < Limbs) quotient[j] = (std::uint64_t)guess;
+             }
+
+               //Both the remainder and v are scaled, so they still compare.
+            std::array<std::uint64_t, Limbs + 1> twice, divisor;
+            carry = 0;
+            for (std::size_t i = 0; i < n; i++)
+             {
+               twice[i] = from[i] * 2 + carry;
+               carry = (twice[i] >= Base) ? 1 : 0;
+               if (carry) twice[i] -= Base;
+               divisor[i] = v[i];
+             }
+            twice[n] = carry;
+            divisor[n] = 0;
+
+            comp = compare(divisor, twice);
+            zero = isZero(twice);
+          }
+
+
+            //Rounds the significand up, to 10 ^ Digits and the next
+            //Exponent if it reaches 10 ^ (Digits + 1).
+         void roundUp (void)
+          {
+            if (!increment(Data) && (countDigits(Data) <= Digits + 1)) return;
+            Data.fill(0);
+            Data[Digits / LimbDigits] = tenTo(Digits % LimbDigits);
+            Exponent++;
+          }
+
+            //Overflow to Infinity or underflow to zero.
+         void finish (void)
+          {
+            if (Exponent > Float::getMaxExponent())
+             {
+               Infinity = true;
+               Exponent = 0;
+               Data.fill(0);
+             }
+            else if (Exponent < Float::getMinExponent())
+             {
+               Exponent = 0;
+               Data.fill(0);
+             }
+          }
+
+         static FixedPrecisionFloat makeNaN (long code)
+          {
+            FixedPrecisionFloat result;
+            result.NaN = code;
+            return result;
+          }
+
+         static FixedPrecisionFloat makeInfinity (bool sign)
+          {
+            FixedPrecisionFloat result;
+            result.Infinity = true;
+            result.Sign = sign;
+            return result;
+          }
+
+
+            //What Float's operators + and - share.
+         static FixedPrecisionFloat sum (const FixedPrecisionFloat & lhs,
+                                         const FixedPrecisionFloat & rhs,
+                                         bool negate)
+          {
+            bool rSign = rhs.Sign ^ negate;
+
+            if (lhs.NaN || rhs.NaN) return makeNaN(lhs.NaN | rhs.NaN);
+
+            if (lhs.Infinity && rhs.Infinity)
+             {
+               if (lhs.Sign != rSign) return makeNaN(1);
+               return makeInfinity(lhs.Sign);
+             }
+            if (lhs.Infinity) return makeInfinity(lhs.Sign);
+            if (rhs.Infinity) return makeInfinity(rSign);
+
+            if (lhs.isZero() && rhs.isZero() && (lhs.Sign != rSign))
+               return FixedPrecisionFloat();
+            if (rhs.isZero()) return lhs;
+            if (lhs.isZero())
+             {
+               FixedPrecisionFloat result (rhs);
+               result.Sign = rSign;
+               return result;
+             }
+
+               //Make big the one with the larger Exponent.
+            const FixedPrecisionFloat & big =
+               (lhs.Exponent >= rhs.Exponent) ? lhs : rhs;
+            const FixedPrecisionFloat & small =
+               (lhs.Exponent >= rhs.Exponent) ? rhs : lhs;
+            bool bigSign = (lhs.Exponent >= rhs.Exponent) ? lhs.Sign : rSign;
+            bool smallSign = (lhs.Exponent >= rhs.Exponent) ? rSign : lhs.Sign;
+            unsigned long diff = (unsigned long)(big.Exponent - small.Exponent);
+            long low = small.Exponent;
+
+            Product x, y;
+            x.fill(0);
+            y.fill(0);
+            for (std::size_t i = 0; i < Limbs; i++) x[i] = big.Data[i];
+
+               /*
+                  When all of small is below a tenth of the last place that
+                  the result can have, only its sign matters to the
+                  rounding, so it becomes a single sticky digit there.
+               */
+            if (diff > Digits + 2)
+             {
+               diff = Digits + 3;
+               low = big.Exponent - (long)diff;
+               y[0] = 1;
+             }
+            else
+               for (std::size_t i = 0; i < Limbs; i++) y[i] = small.Data[i];
+            shiftUp(x, diff);
+
+            FixedPrecisionFloat result;
+            if (bigSign == smallSign)
+             {
+               add(x, y);
+               result.Sign = bigSign;
+             }
+            else
+             {
+               int order = compare(x, y);
+               if (order == 0) return result;
+               if (order > 0)
+                {
+                  subtract(x, y);
+                  result.Sign = bigSign;
+                }
+               else
+                {
+                  subtract(y, x);
+                  x = y;
+                  result.Sign = smallSign;
+                }
+             }
+
+               //x is in units of 10 ^ (low - Digits).
+            unsigned long digits = countDigits(x);
+            bool round = false;
+            result.Exponent = low + (long)digits - (long)Digits - 1;
+
+               //Like Fixed, only ask decideRound when digits are removed.
+            if (digits > Digits + 1)
+             {
+               int comp;
+               bool zero;
+               shiftDown(x, digits - Digits - 1, comp, zero);
+               round = Fixed::decideRound(result.Sign, !(x[0] & 1), comp, zero);
+             }
+            else if (digits < Digits + 1)
+               shiftUp(x, Digits + 1 - digits);
+
+            for (std::size_t i = 0; i < Limbs; i++) result.Data[i] = x[i];
+            if (round) result.roundUp();
+            result.finish();
+            return result;
+          }
+
+      public:
+
+         FixedPrecisionFloat () :
+            Sign (false), Exponent (0), Infinity (false), NaN (0)
+            { Data.fill(0); }
+
+            //Rounds from to Digits in the current round mode.
+         explicit FixedPrecisionFloat (const Float & from) :
+            Sign (from.Sign), Exponent (0), Infinity (from.Infinity),
+            NaN (from.NaN)
+          {
+            Data.fill(0);
+            if (!from.isUnSpecial()) return;
+
+            Float temp (from);
+            temp.setPrecision(Digits);
+            if (temp.Infinity)
+             {
+               Infinity = true;
+               return;
+             }
+            Exponent = temp.Exponent;
+
+            std::string digits = temp.Data.toString();
+            std::uint64_t place = 1;
+            std::size_t limb = 0;
+            for (std::size_t i = digits.length(); i-- > 0; )
+             {
+               if ((digits[i] < '0') || (digits[i] > '9')) continue;
+               Data[limb] += (std::uint64_t)(digits[i] - '0') * place;
+               place *= 10;
+               if (place == Base)
+                {
+                  place = 1;
+                  limb++;
+                }
+             }
+          }
+
+         explicit FixedPrecisionFloat (const std::string & from) :
+            FixedPrecisionFloat (Float(from)) { }
+         explicit FixedPrecisionFloat (const char * from) :
+            FixedPrecisionFloat (Float(from)) { }
+
+         Float toFloat (void) const
+          {
+            Float result;
+            result.Sign = Sign;
+            result.Infinity = Infinity;
+            result.NaN = NaN;
+            if (Infinity || NaN) return result;
+            if (isZero())
+             {
+               result.Data = Fixed(0, Digits);
+               return result;
+             }
+
+            result.Data = Fixed(significand());
+            result.Exponent = Exponent;
+            return result;
+          }
+
+            //The significand as "d.ddd", with Digits digits after the point.
+         std::string significand (void) const
+          {
+            std::string result (Limbs * LimbDigits, '0');
+            for (std::size_t i = 0; i < Limbs; i++)
+             {
+               std::uint64_t limb = Data[i];
+               for (unsigned long j = 0; j < LimbDigits; j++)
+                {
+                  result[result.length() - 1 - i * LimbDigits - j] =
+                     (char)('0' + limb % 10);
+                  limb /= 10;
+                }
+             }
+            result = result.substr(result.length() - Digits - 1);
+            if (Digits > 0) result.insert(1, 1, '.');
+            return result;
+          }
+
+            //The same as Float's.
+         std::string toString (void) const
+          {
+            if (NaN) return std::string ("NaN");
+            if (Infinity)
+             {
+               if (Sign) return std::string ("-Inf");
+               else return std::string ("Inf");
+             }
+            std::string result ("");
+            if (Sign) result += "-";
+            result += significand();
+            result += "E";
+            result += std::to_string(Exponent);
+            return result;
+          }
+
+         static unsigned long getPrecision (void) { return Digits; }
+
+         long exponent (void) const { return Exponent; }
+
+         bool isSigned (void) const { return Sign; }
+         bool isInfinity (void) const { return Infinity; }
+         long isNaN (void) const { return NaN; }
+         bool isZero (void) const
+            { if (Infinity || NaN) return false; return isZero(Data); }
+
+         bool isUnSpecial (void) const
+            { return !(isZero() || NaN || Infinity); }
+
+         FixedPrecisionFloat & negate (void)
+            { Sign = !Sign; return *this; }
+         FixedPrecisionFloat & abs (void)
+            { Sign = false; return *this; }
+
+         FixedPrecisionFloat operator - (void) const
+          { FixedPrecisionFloat result (*this); result.negate();
+            return result; }
+
+            //Only works for finite, nonzero _numbers_
+         int compare (const FixedPrecisionFloat & rhs) const
+          {
+            if (Sign != rhs.Sign) return Sign ? -1 : 1;
+            int order;
+            if (Exponent != rhs.Exponent)
+               order = (Exponent > rhs.Exponent) ? 1 : -1;
+            else
+               order = compare(Data, rhs.Data);
+            return Sign ? -order : order;
+          }
+
+         friend FixedPrecisionFloat operator +
+            (const FixedPrecisionFloat & lhs, const FixedPrecisionFloat & rhs)
+          { return sum(lhs, rhs, false); }
+
+         friend FixedPrecisionFloat operator -
+            (const FixedPrecisionFloat & lhs, const FixedPrecisionFloat & rhs)
+          { return sum(lhs, rhs, true); }
+
+         friend FixedPrecisionFloat operator *
+            (const FixedPrecisionFloat & lhs, const FixedPrecisionFloat & rhs)
+          {
+            if (lhs.NaN || rhs.NaN) return makeNaN(lhs.NaN | rhs.NaN);
+            if ((lhs.Infinity && rhs.isZero()) ||
+                (lhs.isZero() && rhs.Infinity))
+               return makeNaN(2);
+
+            bool sign = lhs.Sign ^ rhs.Sign;
+            if (lhs.Infinity || rhs.Infinity) return makeInfinity(sign);
+
+            FixedPrecisionFloat result;
+            result.Sign = sign;
+            if (lhs.isZero() || rhs.isZero()) return result;
+
+            Product product;
+            multiply(lhs.Data, rhs.Data, product);
+
+               //The product has 2 * Digits + 1 or 2 * Digits + 2 digits.
+            unsigned long digits = countDigits(product);
+            bool round = false;
+            if (digits > Digits + 1)
+             {
+               int comp;
+               bool zero;
+               shiftDown(product, digits - Digits - 1, comp, zero);
+               round = Fixed::decideRound(sign, !(product[0] & 1), comp, zero);
+             }
+
+            for (std::size_t i = 0; i < Limbs; i++)
+               result.Data[i] = product[i];
+            result.Exponent = lhs.Exponent + rhs.Exponent +
+               (long)(digits - 2 * Digits - 1);
+            if (round) result.roundUp();
+            result.finish();
+            return result;
+          }
+
+         friend FixedPrecisionFloat operator /
+            (const FixedPrecisionFloat & lhs, const FixedPrecisionFloat & rhs)
+          {
+            if (lhs.NaN || rhs.NaN) return makeNaN(lhs.NaN | rhs.NaN);
+            if (lhs.isZero() && rhs.isZero()) return makeNaN(4);
+            if (lhs.Infinity && rhs.Infinity) return makeNaN(8);
+
+            bool sign = lhs.Sign ^ rhs.Sign;
+            if (lhs.Infinity || rhs.isZero()) return makeInfinity(sign);
+
+            FixedPrecisionFloat result;
+            result.Sign = sign;
+            if (lhs.isZero() || rhs.Infinity) return result;
+
+               //Scale the dividend so that the quotient has Digits + 1
+               //digits.
+            int smaller = compare(lhs.Data, rhs.Data) < 0 ? 1 : 0;
+            Product dividend;
+            dividend.fill(0);
+            for (std::size_t i = 0; i < Limbs; i++) dividend[i] = lhs.Data[i];
+            shiftUp(dividend, Digits + (unsigned long)smaller);
+
+            int comp;
+            bool zero;
+            divide(dividend, rhs.Data, result.Data, comp, zero);
+
+            result.Exponent = lhs.Exponent - rhs.Exponent - smaller;
+            if (Fixed::decideRound(sign, !(result.Data[0] & 1), comp, zero))
+               result.roundUp();
+            result.finish();
+            return result;
+          }
+
+         FixedPrecisionFloat & operator += (const FixedPrecisionFloat & rhs)
+            { return (*this = *this + rhs); }
+         FixedPrecisionFloat & operator -= (const FixedPrecisionFloat & rhs)
+            { return (*this = *this - rhs); }
+         FixedPrecisionFloat & operator *= (const FixedPrecisionFloat & rhs)
+            { return (*this = *this * rhs); }
+         FixedPrecisionFloat & operator /= (const FixedPrecisionFloat & rhs)
+            { return (*this = *this / rhs); }
+
+         friend bool operator ==
+            (const FixedPrecisionFloat & lhs, const FixedPrecisionFloat & rhs)
+          {
+            if (lhs.NaN || rhs.NaN) return false;
+            if (lhs.isZero() && rhs.isZero()) return true;
+            if (lhs.Infinity || rhs.Infinity)
+               return lhs.Infinity && rhs.Infinity && (lhs.Sign == rhs.Sign);
+            return (lhs.Sign == rhs.Sign) && (lhs.Exponent == rhs.Exponent) &&
+               (compare(lhs.Data, rhs.Data) == 0);
+          }
+
+         friend bool operator !=
+            (const FixedPrecisionFloat & lhs, const FixedPrecisionFloat & rhs)
+          { return !(lhs.NaN || rhs.NaN) && !(lhs == rhs); }
+
+         friend bool operator <
+            (const FixedPrecisionFloat & lhs, const FixedPrecisionFloat & rhs)
+          {
+            if (lhs.NaN || rhs.NaN) return false;
+            if (lhs.Infinity || rhs.Infinity)
+             {
+               if (lhs.Infinity && rhs.Infinity)
+                  return lhs.Sign && !rhs.Sign;
+               if (lhs.Infinity) return lhs.Sign;
+               return !rhs.Sign;
+             }
+            if (lhs.isZero() && rhs.isZero()) return false;
+            if (lhs.isZero()) return !rhs.Sign;
+            if (rhs.isZero()) return lhs.Sign;
+            return lhs.compare(rhs) < 0;
+          }
+
+         friend bool operator >
+            (const FixedPrecisionFloat & lhs, const FixedPrecisionFloat & rhs)
+          { return rhs < lhs; }
+         friend bool operator <=
+            (const FixedPrecisionFloat & lhs, const FixedPrecisionFloat & rhs)
+          { return (lhs < rhs) || (lhs == rhs); }
+         friend bool operator >=
+            (const FixedPrecisionFloat & lhs, const FixedPrecisionFloat & rhs)
+          { return (rhs < lhs) || (lhs == rhs); }
+
+    }; /* class FixedPrecisionFloat */
+
+ } /* namespace BigInt */
+
+#endif /* FIXEDFLOAT_HPP */
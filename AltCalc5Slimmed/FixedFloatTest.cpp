@@ -0,0 +1,254 @@
+/*
+Copyright (c) 2013 Thomas DiModica.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+3. Neither the name of Thomas DiModica nor the names of other contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THOMAS DIMODICA AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THOMAS DIMODICA OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+SUCH DAMAGE.
+*/
+
+/*
+   Checks that FixedPrecisionFloat's +, -, * and / are correctly rounded,
+   in every round mode, against the exact result worked out with Integers
+   and then rounded once. FixedFloatTest.sh builds and runs it;
+   it prints each failure and exits nonzero if there are any.
+*/
+#include <cstdio>
+#include <random>
+#include <string>
+
+#include "FixedFloat.hpp"
+
+using namespace BigInt;
+
+static int failures = 0;
+
+static const Fixed_Round_Mode modes [] =
+ {
+   ROUND_TIES_EVEN, ROUND_TIES_AWAY, ROUND_POSITIVE_INFINITY,
+   ROUND_NEGATIVE_INFINITY, ROUND_ZERO, ROUND_TIES_ODD, ROUND_TIES_ZERO,
+   ROUND_AWAY, ROUND_05_AWAY
+ };
+static const int MODES = 9;
+
+static std::mt19937_64 source (20131);
+
+static Integer tenTo (long power)
+ { return pow(Integer(10), Integer(power)); }
+
+   /*
+      Digits + 1 random digits, but often with long runs of nines or zeros,
+      so that sums and differences carry and cancel.
+   */
+template <unsigned long Digits>
+static FixedPrecisionFloat<Digits> random (long exponents)
+ {
+   std::string digits;
+   int kind = (int)(source() % 4);
+   for (unsigned long i = 0; i <= Digits; i++)
+    {
+      char next = (char)('0' + source() % 10);
+      if ((i > 0) && (source() % 4 != 0))
+       {
+         if (kind == 1) next = '9';
+         if (kind == 2) next = '0';
+       }
+      if ((i == 0) && (next == '0')) next = '1';
+      digits += next;
+    }
+   if (source() % 2) digits = "-" + digits;
+
+   long exponent = (long)(source() % (unsigned long)(2 * exponents + 1)) -
+      exponents - (long)Digits;
+   return FixedPrecisionFloat<Digits>(Float(Integer(digits), exponent, Digits));
+ }
+
+   //x as an exact Integer times 10 ^ exponent.
+template <unsigned long Digits>
+static Integer exact (const FixedPrecisionFloat<Digits> & x, long & exponent)
+ {
+   Float from (x.toFloat());
+   exponent = from.exponent() - (long)Digits;
+   return from.toInteger(exponent);
+ }
+
+   /*
+      Rounds value * 10 ^ exponent to Digits + 1 digits, once, with Fixed's
+      decideRound. Float isn't used for this, as its constructor can apply
+      ROUND_05_AWAY twice.
+   */
+template <unsigned long Digits>
+static void roundOnce (Integer & value, long & exponent)
+ {
+   if (value.isZero()) return;
+
+   bool sign = value.isSigned();
+   value.abs();
+   long removed = (long)value.toString().length() - (long)Digits - 1;
+   if (removed < 0) value = value * tenTo(-removed);
+   else if (removed > 0)
+    {
+      Integer scale (tenTo(removed)), rem;
+      Integer::divmod(value, scale, value, rem);
+      rem = rem * Integer(2);
+      if (Fixed::decideRound(sign, value.isEven(), scale.compare(rem),
+                             rem.isZero()))
+       {
+         value = value + Integer(1);
+         if (value.compare(tenTo((long)Digits + 1)) == 0)
+          {
+            value = tenTo((long)Digits);
+            removed++;
+          }
+       }
+    }
+   exponent += removed;
+   if (sign) value = -value;
+ }
+
+template <unsigned long Digits>
+static Integer sum (const FixedPrecisionFloat<Digits> & lhs,
+                    const FixedPrecisionFloat<Digits> & rhs, bool negate,
+                    long & exponent)
+ {
+   long lExp, rExp;
+   Integer l (exact(lhs, lExp)), r (exact(rhs, rExp));
+   if (negate) r = -r;
+
+   exponent = (lExp < rExp) ? lExp : rExp;
+   return l * tenTo(lExp - exponent) + r * tenTo(rExp - exponent);
+ }
+
+template <unsigned long Digits>
+static Integer product (const FixedPrecisionFloat<Digits> & lhs,
+                        const FixedPrecisionFloat<Digits> & rhs,
+                        long & exponent)
+ {
+   long lExp, rExp;
+   Integer l (exact(lhs, lExp)), r (exact(rhs, rExp));
+   exponent = lExp + rExp;
+   return l * r;
+ }
+
+   //Enough digits of the quotient, and a sticky digit for the rest.
+template <unsigned long Digits>
+static Integer quotient (const FixedPrecisionFloat<Digits> & lhs,
+                         const FixedPrecisionFloat<Digits> & rhs,
+                         long & exponent)
+ {
+   long lExp, rExp, extra = 2 * (long)Digits + 4;
+   Integer l (exact(lhs, lExp)), r (exact(rhs, rExp)), q, rem;
+   bool sign = l.isSigned() != r.isSigned();
+
+   l.abs();
+   r.abs();
+   Integer::divmod(l * tenTo(extra), r, q, rem);
+   q = q * Integer(10) + Integer(rem.isZero() ? 0 : 1);
+   if (sign) q = -q;
+   exponent = lExp - rExp - extra - 1;
+   return q;
+ }
+
+template <unsigned long Digits>
+static void check (const FixedPrecisionFloat<Digits> & lhs, char op,
+                   const FixedPrecisionFloat<Digits> & rhs,
+                   const FixedPrecisionFloat<Digits> & got,
+                   Integer expected, long exponent, int mode)
+ {
+   roundOnce<Digits>(expected, exponent);
+
+   bool ok;
+   long gotExponent = 0;
+   Integer result;
+   if (expected.isZero() || got.isZero())
+      ok = expected.isZero() && got.isZero();
+   else
+    {
+      result = exact(got, gotExponent);
+      ok = (result.compare(expected) == 0) && (gotExponent == exponent);
+    }
+
+   if (!ok)
+    {
+      std::printf("FAILED: %s %c %s in mode %d at %lu digits: %s, not %sE%ld\n",
+         lhs.toString().c_str(), op, rhs.toString().c_str(), mode, Digits,
+         got.toString().c_str(), expected.toString().c_str(), exponent);
+      failures++;
+    }
+ }
+
+template <unsigned long Digits>
+static void operators (int count)
+ {
+   for (int i = 0; i < count; i++)
+    {
+         //Spread the exponents past where one addend can't be seen.
+      FixedPrecisionFloat<Digits> lhs (random<Digits>(0));
+      FixedPrecisionFloat<Digits> rhs (random<Digits>((long)Digits * 2 + 6));
+      if (source() % 2) std::swap(lhs, rhs);
+
+      for (int m = 0; m < MODES; m++)
+       {
+         long exponent;
+         Fixed::setRoundMode(modes[m]);
+
+         Integer expected (sum(lhs, rhs, false, exponent));
+         check(lhs, '+', rhs, lhs + rhs, expected, exponent, m);
+         expected = sum(lhs, rhs, true, exponent);
+         check(lhs, '-', rhs, lhs - rhs, expected, exponent, m);
+         expected = product(lhs, rhs, exponent);
+         check(lhs, '*', rhs, lhs * rhs, expected, exponent, m);
+         expected = quotient(lhs, rhs, exponent);
+         check(lhs, '/', rhs, lhs / rhs, expected, exponent, m);
+       }
+      Fixed::setRoundMode(ROUND_TIES_EVEN);
+    }
+ }
+
+   //Float's change() drops the smaller operand here.
+static void tooSmallForFloat (void)
+ {
+   FixedPrecisionFloat<17> lhs ("999999999999999999999");
+   FixedPrecisionFloat<17> rhs ("963.822");
+   std::string got ((lhs - rhs).toString());
+
+   if (got != "9.99999999999999999E20")
+    {
+      std::printf("FAILED: 999999999999999999999 - 963.822: %s\n",
+         got.c_str());
+      failures++;
+    }
+ }
+
+int main (void)
+ {
+   tooSmallForFloat();
+   operators<1>(2000);
+   operators<17>(2000);
+   operators<18>(2000);
+   operators<35>(1000);
+   operators<40>(1000);
+
+   if (failures == 0) std::printf("All passed\n");
+   return (failures == 0) ? 0 : 1;
+ }
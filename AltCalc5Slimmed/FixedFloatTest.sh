@@ -0,0 +1 @@
+g++ -O2 -Wall -Wextra -Wpedantic -Wconversion -o FixedFloatTest FixedFloatTest.cpp Float.cpp Fixed.cpp Integer.cpp BitField.cpp && ./FixedFloatTest
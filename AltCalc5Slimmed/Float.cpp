@@ -27,10 +27,13 @@ OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
 SUCH DAMAGE.
 */
 
+#include <cfloat>
+#include <cmath>
 #include <cstdlib>
 #include <string>
 #include <sstream>
 #include <cstring>
+#include <utility>
 #include "Float.hpp"
 
 #ifndef SEPERATOR
@@ -65,6 +68,65 @@ namespace BigInt
     }
 
 
+   Float::Float (const Integer & mantissa, long exponent,
+                 unsigned long precision) :
+      Data (mantissa, 0), Sign (mantissa.isSigned()), Exponent (0),
+      Infinity (false), NaN (0)
+    {
+      Data.abs();
+      if (Data.isZero())
+       {
+         Data.setPrecision(precision);
+         return;
+       }
+
+         //A guess at the number of digits, less one, that normalize fixes.
+      long digits = (long)((double)mantissa.msb() * 0.30102999566398120);
+
+      if ((exponent + digits) > maxExponent)
+       {
+         Infinity = true;
+         Data = Fixed(0, minPrecision);
+         return;
+       }
+      if ((exponent + digits) < (minExponent - 1))
+       {
+         Data = Fixed(0, minPrecision);
+         return;
+       }
+
+      Data.setPrecision(digits);
+      Exponent = exponent + digits;
+      normalize();
+
+      if (Exponent < minExponent)
+       {
+         Exponent = 0;
+         Data = Fixed(0, minPrecision);
+       }
+      else if (!Infinity) setPrecision(precision);
+    }
+
+   Integer Float::toInteger (long exponent) const
+    {
+      if (!isUnSpecial()) return Integer();
+
+      Fixed temp (Data);
+      long digits = Exponent - exponent;
+
+      temp.setSign(Sign);
+      if (digits >= 0)
+       {
+         temp.changePrecision(digits);
+         temp.setPrecision(0);
+       }
+      else
+         temp.setPrecision(temp.getPrecision() - digits);
+
+      return temp.roundToInteger();
+    }
+
+
    void Float::precisionChanger(unsigned long newPrecision)
     {
       bool checkOverflow = newPrecision < Data.getPrecision();
@@ -185,22 +247,26 @@ namespace BigInt
 
    Float & operator += (Float & lval, const Float & rval)
     {
-      return (lval = lval + rval);
+      if (&lval == &rval) return (lval = lval + rval);
+      return (lval = std::move(lval) + rval);
     }
 
    Float & operator -= (Float & lval, const Float & rval)
     {
-      return (lval = lval - rval);
+      if (&lval == &rval) return (lval = lval - rval);
+      return (lval = std::move(lval) - rval);
     }
 
    Float & operator *= (Float & lval, const Float & rval)
     {
-      return (lval = lval * rval);
+      if (&lval == &rval) return (lval = lval * rval);
+      return (lval = std::move(lval) * rval);
     }
 
    Float & operator /= (Float & lval, const Float & rval)
     {
-      return (lval = lval / rval);
+      if (&lval == &rval) return (lval = lval / rval);
+      return (lval = std::move(lval) / rval);
     }
 
 
@@ -215,6 +281,17 @@ namespace BigInt
       return *this;
     }
 
+   Float & Float::operator = (Float && src)
+    {
+      if (&src == this) return *this;
+      Data = std::move(src.Data);
+      Sign = src.Sign;
+      Exponent = src.Exponent;
+      Infinity = src.Infinity;
+      NaN = src.NaN;
+      return *this;
+    }
+
    Float & Float::operator |= (const Float & src)
     {
       if (&src == this) return *this;
@@ -289,7 +366,267 @@ namespace BigInt
     }
 
 
+    /*
+      The fast paths. At up to FASTPATHDIGITS digits the scaled Integers of
+      both operands fit in a Unit, and everything done to them fits in an
+      unsigned __int128. Each kernel takes exactly the steps, and makes
+      exactly the roundings, that the Fixed code would, so the results are
+      the same to the last digit in every rounding mode: they just don't
+      allocate. Anything out of the ordinary, like an over- or underflow or
+      a zero sum, is left to the general code.
+    */
+   unsigned long FASTPATHDIGITS = 18;
+   unsigned long FASTPATHHITS = 0;
+
+#ifdef __SIZEOF_INT128__
+
+   __extension__ typedef unsigned __int128 Wide;
+
+   static const unsigned long WideDigits = 38; //10^38 < 2^128 / 2
+
+   static Wide tenTo (unsigned long power)
+    {
+      static const struct Table
+       {
+         Wide Power [WideDigits + 1];
+         Table ()
+          {
+            Power[0] = 1;
+            for (unsigned long i = 1; i <= WideDigits; i++)
+               Power[i] = Power[i - 1] * 10;
+          }
+       } table;
+      return table.Power[power];
+    }
+
+    //Fixed::changePrecision, dropping the last places digits of a magnitude.
+   static Wide wideRound (Wide from, unsigned long places, bool sign)
+    {
+      if (places == 0) return from;
+
+      Wide scale = tenTo(places), result = from / scale;
+      Wide rem = (from % scale) * 2;
+      int comp = (scale > rem) ? 1 : ((scale < rem) ? -1 : 0);
+
+      if (Fixed::decideRound(sign, !(result & 1), comp, rem == 0)) result++;
+      return result;
+    }
+
+    //from * 10^places, if that is less than 10^WideDigits.
+   static bool wideScale (Unit from, unsigned long places, Wide & to)
+    {
+      if ((places > WideDigits) || ((Wide)from >= tenTo(WideDigits - places)))
+         return false;
+      to = (Wide)from * tenTo(places);
+      return true;
+    }
+
+   static bool fitsUnit (Wide value)
+    {
+      return (value >> (8 * sizeof(Unit))) == 0;
+    }
+
+   static bool fastOperands (const Fixed & lhs, const Fixed & rhs,
+                             Unit & left, Unit & right)
+    {
+      unsigned long most = FASTPATHDIGITS < 18 ? FASTPATHDIGITS : 18;
+
+      if ((lhs.getPrecision() == 0) || (lhs.getPrecision() > most) ||
+          (rhs.getPrecision() == 0) || (rhs.getPrecision() > most))
+         return false;
+      return lhs.toUnit(left) && rhs.toUnit(right);
+    }
+
+
+    /*
+      What operator + does for two unspecial Floats that change() each
+      other: align, add, normalize and round to the larger precision.
+      negate subtracts instead.
+    */
+   bool Float::fastAdd (const Float & lhs, const Float & rhs, bool negate,
+                        Float & result)
+    {
+      Unit left, right;
+      if (!fastOperands(lhs.Data, rhs.Data, left, right)) return false;
+
+      unsigned long lDigits = lhs.Data.getPrecision();
+      unsigned long rDigits = rhs.Data.getPrecision();
+      unsigned long precision = lDigits > rDigits ? lDigits : rDigits;
+      long exponent;
+
+      if (lhs.Exponent > rhs.Exponent)
+       {
+         exponent = lhs.Exponent;
+         rDigits += (unsigned long)(lhs.Exponent - rhs.Exponent);
+       }
+      else
+       {
+         exponent = rhs.Exponent;
+         lDigits += (unsigned long)(rhs.Exponent - lhs.Exponent);
+       }
+
+      unsigned long digits = lDigits > rDigits ? lDigits : rDigits;
+      Wide x, y, sum;
+      bool lSign = lhs.Sign, rSign = rhs.Sign ^ negate, sign;
+
+      if (!wideScale(left, digits - lDigits, x) ||
+          !wideScale(right, digits - rDigits, y))
+         return false;
+
+      if (lSign == rSign) { sum = x + y; sign = lSign; }
+      else if (x >= y) { sum = x - y; sign = lSign; }
+      else { sum = y - x; sign = rSign; }
+
+      if (sum == 0) return false;
+
+         //normalize
+      if (sum >= tenTo(digits + 1))
+       {
+         if ((exponent + 1) > maxExponent) return false;
+         digits++;
+         exponent++;
+       }
+      else
+       {
+         unsigned long places = 0;
+         while ((places < digits) && (sum >= tenTo(places + 1))) places++;
+         exponent -= (long)(digits - places);
+         if (exponent < minExponent) return false;
+         digits = places;
+       }
+
+         //precisionChanger
+      if (precision > digits)
+         sum *= tenTo(precision - digits);
+      else if (precision < digits)
+       {
+         sum = wideRound(sum, digits - precision, sign);
+         if (sum >= tenTo(precision + 1))
+          {
+            if ((exponent + 1) > maxExponent) return false;
+            sum = wideRound(sum, 1, false);
+            exponent++;
+          }
+       }
+
+      if (!fitsUnit(sum)) return false;
+
+      result.Data = Fixed(Integer((Unit)sum), precision);
+      result.Sign = sign;
+      result.Exponent = exponent;
+      FASTPATHHITS++;
+      return true;
+    }
+
+    /*
+      Fixed::multiply, and the sticky bump of the Exponent after it.
+    */
+   bool Float::fastMultiply (const Float & lhs, const Float & rhs,
+                             Float & result)
+    {
+      Unit left, right;
+      if (!fastOperands(lhs.Data, rhs.Data, left, right)) return false;
+
+      long exponent = lhs.Exponent + rhs.Exponent;
+      if ((exponent < minExponent) || (exponent >= maxExponent)) return false;
+
+      unsigned long lDigits = lhs.Data.getPrecision();
+      unsigned long rDigits = rhs.Data.getPrecision();
+      unsigned long precision = lDigits > rDigits ? lDigits : rDigits;
+      unsigned long digits = lDigits + rDigits;
+      Wide product = (Wide)left * right;
+
+      if (product >= tenTo(digits + 1))
+       {
+         product = wideRound(product, digits - precision + 1, false);
+         exponent++;
+       }
+      else
+       {
+         product = wideRound(product, digits - precision, false);
+         if (product >= tenTo(precision + 1))
+          {
+            product = wideRound(product, 1, false);
+            exponent++;
+          }
+       }
+
+      if (!fitsUnit(product)) return false;
+
+      result.Data = Fixed(Integer((Unit)product), precision);
+      result.Exponent = exponent;
+      FASTPATHHITS++;
+      return true;
+    }
+
+    /*
+      Fixed's operator /, and the sticky drop of the Exponent after it.
+    */
+   bool Float::fastDivide (const Float & lhs, const Float & rhs,
+                           Float & result)
+    {
+      Unit left, right;
+      if (!fastOperands(lhs.Data, rhs.Data, left, right)) return false;
+
+      long exponent = lhs.Exponent - rhs.Exponent;
+      if ((exponent <= minExponent) || (exponent > maxExponent)) return false;
+
+      unsigned long lDigits = lhs.Data.getPrecision();
+      unsigned long rDigits = rhs.Data.getPrecision();
+      unsigned long oneExtra =
+         ((Wide)right * tenTo(lDigits) > (Wide)left * tenTo(rDigits)) ? 1 : 0;
+      unsigned long places, digits;
+
+      if (lDigits > rDigits)
+       {
+         places = rDigits + oneExtra;
+         digits = lDigits + oneExtra;
+       }
+      else
+       {
+         places = 2 * rDigits - lDigits + oneExtra;
+         digits = rDigits + oneExtra;
+       }
+
+      Wide dividend;
+      if (!wideScale(left, places, dividend)) return false;
+
+      Wide quotient = dividend / right, rem = (dividend % right) * 2;
+      int comp = (right > rem) ? 1 : ((right < rem) ? -1 : 0);
+
+      if (Fixed::decideRound(false, !(quotient & 1), comp, rem == 0))
+         quotient++;
+
+      if (!fitsUnit(quotient)) return false;
+
+      result.Data = Fixed(Integer((Unit)quotient), digits - oneExtra);
+      result.Exponent = exponent - (long)oneExtra;
+      FASTPATHHITS++;
+      return true;
+    }
+
+#else /* ! __SIZEOF_INT128__ */
+
+   bool Float::fastAdd (const Float &, const Float &, bool, Float &)
+    { return false; }
+   bool Float::fastMultiply (const Float &, const Float &, Float &)
+    { return false; }
+   bool Float::fastDivide (const Float &, const Float &, Float &)
+    { return false; }
+
+#endif /* __SIZEOF_INT128__ */
+
+
+    /*
+      The operators work on a copy of lhs, so the rvalue versions do the
+      real work, in place in lhs.
+    */
    Float operator + (const Float & lhs, const Float & rhs)
+    {
+      return Float(lhs) + rhs;
+    }
+
+   Float operator + (Float && lhs, const Float & rhs)
     {
       Float temp;
        /*
@@ -348,33 +685,39 @@ namespace BigInt
          //Finally, zeros.
       if (lhs.isZero() && rhs.isZero() && (lhs.Sign != rhs.Sign))
          return temp;
-      if (rhs.isZero()) return lhs;
+      if (rhs.isZero()) return std::move(lhs);
       if (lhs.isZero()) return rhs;
 
          //Do we need to compute anything?
       if (change(lhs, rhs))
        {
-         Float temp1 (lhs), temp2 (rhs);
+         if (Float::fastAdd(lhs, rhs, false, temp)) return temp;
+
+         Float temp2 (rhs);
+         unsigned long precision =
+            lhs.Data.getPrecision() > rhs.Data.getPrecision() ?
+            lhs.Data.getPrecision() : rhs.Data.getPrecision();
+
             //Denormalize the Precisions to take account of the Exponents
-         if (temp1.Exponent > temp2.Exponent)
+         if (lhs.Exponent > temp2.Exponent)
           {
-            temp.Exponent = temp1.Exponent;
+            temp.Exponent = lhs.Exponent;
             temp2.Data.setPrecision
-               (temp2.Data.getPrecision() + temp1.Exponent - temp2.Exponent);
+               (temp2.Data.getPrecision() + lhs.Exponent - temp2.Exponent);
           }
-         else if (temp1.Exponent < temp2.Exponent)
+         else if (lhs.Exponent < temp2.Exponent)
           {
             temp.Exponent = temp2.Exponent;
-            temp1.Data.setPrecision
-               (temp1.Data.getPrecision() + temp2.Exponent - temp1.Exponent);
+            lhs.Data.setPrecision
+               (lhs.Data.getPrecision() + temp2.Exponent - lhs.Exponent);
           }
-         else temp.Exponent = temp1.Exponent;
+         else temp.Exponent = lhs.Exponent;
 
             //Assign the correct signs before operating
-         temp1.Data.setSign(temp1.Sign);
+         lhs.Data.setSign(lhs.Sign);
          temp2.Data.setSign(temp2.Sign);
 
-         temp.Data = temp1.Data + temp2.Data;
+         temp.Data = std::move(lhs.Data) + temp2.Data;
 
             //Clear the sign
          temp.Sign = temp.Data.isSigned();
@@ -382,13 +725,13 @@ namespace BigInt
 
             //Normalize result
          temp.normalize();
-         temp.setPrecision(lhs.Data.getPrecision() > rhs.Data.getPrecision() ?
-            lhs.Data.getPrecision() : rhs.Data.getPrecision());
+         temp.setPrecision(precision);
        }
       else
        {
             //Just return either the lhs or the rhs
-         temp = lhs.Exponent > rhs.Exponent ? lhs : rhs;
+         if (lhs.Exponent > rhs.Exponent) temp = std::move(lhs);
+         else temp = rhs;
             //We don't change the precision of the result,
             //because we haven't added any meaningful information
             //For example: 2.0 + 1.000E-16 should not be 2.000
@@ -398,6 +741,11 @@ namespace BigInt
     }
 
    Float operator - (const Float & lhs, const Float & rhs)
+    {
+      return Float(lhs) - rhs;
+    }
+
+   Float operator - (Float && lhs, const Float & rhs)
     {
       Float temp;
 
@@ -440,47 +788,58 @@ namespace BigInt
 
       if (lhs.isZero() && rhs.isZero() && (lhs.Sign == rhs.Sign))
          return temp;
-      if (rhs.isZero()) return lhs;
+      if (rhs.isZero()) return std::move(lhs);
       if (lhs.isZero()) return -rhs;
 
       if (change(lhs, rhs))
        {
-         Float temp1 (lhs), temp2 (rhs);
-         if (temp1.Exponent > temp2.Exponent)
+         if (Float::fastAdd(lhs, rhs, true, temp)) return temp;
+
+         Float temp2 (rhs);
+         unsigned long precision =
+            lhs.Data.getPrecision() > rhs.Data.getPrecision() ?
+            lhs.Data.getPrecision() : rhs.Data.getPrecision();
+
+         if (lhs.Exponent > temp2.Exponent)
           {
-            temp.Exponent = temp1.Exponent;
+            temp.Exponent = lhs.Exponent;
             temp2.Data.setPrecision
-               (temp2.Data.getPrecision() + temp1.Exponent - temp2.Exponent);
+               (temp2.Data.getPrecision() + lhs.Exponent - temp2.Exponent);
           }
-         else if (temp1.Exponent < temp2.Exponent)
+         else if (lhs.Exponent < temp2.Exponent)
           {
             temp.Exponent = temp2.Exponent;
-            temp1.Data.setPrecision
-               (temp1.Data.getPrecision() + temp2.Exponent - temp1.Exponent);
+            lhs.Data.setPrecision
+               (lhs.Data.getPrecision() + temp2.Exponent - lhs.Exponent);
           }
-         else temp.Exponent = temp1.Exponent;
+         else temp.Exponent = lhs.Exponent;
 
-         temp1.Data.setSign(temp1.Sign);
+         lhs.Data.setSign(lhs.Sign);
          temp2.Data.setSign(temp2.Sign);
 
-         temp.Data = temp1.Data - temp2.Data;
+         temp.Data = std::move(lhs.Data) - temp2.Data;
 
          temp.Sign = temp.Data.isSigned();
          temp.Data.abs();
 
          temp.normalize();
-         temp.setPrecision(lhs.Data.getPrecision() > rhs.Data.getPrecision() ?
-            lhs.Data.getPrecision() : rhs.Data.getPrecision());
+         temp.setPrecision(precision);
        }
       else
        {
-         temp = lhs.Exponent > rhs.Exponent ? lhs : rhs;
+         if (lhs.Exponent > rhs.Exponent) temp = std::move(lhs);
+         else temp = rhs;
        }
 
       return temp;
     }
 
    Float operator * (const Float & lhs, const Float & rhs)
+    {
+      return Float(lhs) * rhs;
+    }
+
+   Float operator * (Float && lhs, const Float & rhs)
     {
       Float temp;
 
@@ -533,8 +892,10 @@ namespace BigInt
        }
       else
        {
+         if (Float::fastMultiply(lhs, rhs, temp)) return temp;
+
             //Do the multiply
-         temp.Data = lhs.Data * rhs.Data;
+         temp.Data = std::move(lhs.Data) * rhs.Data;
          temp.Exponent = lhs.Exponent + rhs.Exponent;
 
             //Normalize
@@ -563,7 +924,202 @@ namespace BigInt
       return temp;
     }
 
+    /*
+      Both sides of operator * may be the same Float, and then Fixed squares
+      instead of multiplying.
+    */
+   Float sqr (const Float & arg)
+    {
+      Float temp (arg);
+      return std::move(temp) * temp;
+    }
+
+
+    /*
+      The guess is good to about LDBL_DIG digits. Each Newton step squares
+      the error, so the steps are done at precisions that about double:
+      the list of them is made by halving the precision wanted. The steps
+      are
+         y' = y + y * (1 - x * y)              for 1 / x
+         y' = y + y * (1 - x * y * y) / 2      for 1 / sqrt(x)
+      and all of them together cost a few multiplies at full precision.
+    */
+   const static unsigned long NewtonExtra = 4;
+   const static unsigned long GuessDigits = LDBL_DIG - 2;
+
+      //x is m * 10 ^ (exponent - 17), for the 18 digit Integer m.
+      //The sign is kept, so the guess for 1 / x has the right sign.
+   static long double leadingDigits (const Float & x)
+    {
+      return std::strtold(x.toInteger(x.exponent() - 17).toString().c_str(),
+                          NULL) / 1E17L;
+    }
+
+   static Float newton (const Float & x, Float y, unsigned long digits,
+                        bool root)
+    {
+      unsigned long steps [64], count = 0;
+      Float xs [64], half (Integer(5), -1, 1);
+
+         //x to each precision, each rounded from the one before.
+      for (unsigned long q = digits; q > GuessDigits; q = q / 2 + 2)
+       {
+         steps[count] = q;
+         xs[count] = (count == 0) ? x : xs[count - 1];
+         xs[count].setPrecision(q);
+         count++;
+       }
+
+      while (count != 0)
+       {
+         unsigned long q = steps[--count];
+         const Float & xq = xs[count];
+         Float error (Integer(1), 0, q);
+
+         y.setPrecision(q);
+         if (root)
+          {
+            error -= xq * sqr(y);
+            y += y * (error * half);
+          }
+         else
+          {
+            error -= xq * y;
+            y += y * error;
+          }
+       }
+
+      return y;
+    }
+
+   Float recip (const Float & x)
+    {
+      if (!x.isUnSpecial()) return Float(Integer(1), 0, x.getPrecision()) / x;
+
+      unsigned long digits = x.getPrecision() + NewtonExtra;
+      long double guess = 1.0L / leadingDigits(x);
+
+      Float res (newton(x,
+         Float(Integer(std::llround(guess * 1E18L)),
+               -18 - x.exponent(), GuessDigits + 2), digits, false));
+
+      res.setPrecision(x.getPrecision());
+      return res;
+    }
+
+    /*
+      What sqrt in Functions.cpp gives for zeros, NaNs, infinities and
+      negative numbers, so that Float.cpp doesn't need Functions.cpp.
+    */
+   Float sqrtOfSpecial (const Float & x)
+    {
+      Float res (x);
+      if (!x.isZero() && x.isSigned())
+       {
+         res = Float();
+         res.NaN = 16;
+       }
+      return res;
+    }
+
+   Float rsqrt (const Float & x)
+    {
+      if (!x.isUnSpecial() || x.isSigned()) return recip(sqrtOfSpecial(x));
+
+      unsigned long digits = x.getPrecision() + NewtonExtra;
+      long double lead = leadingDigits(x);
+      long half = x.exponent();
+
+         //Take the root of the mantissa times 10 ^ (exponent % 2).
+      if ((half % 2) != 0)
+       {
+         lead *= 10.0L;
+         half--;
+       }
+      half /= 2;
+
+      long double guess = 1.0L / std::sqrt(lead);
+
+      Float res (newton(x,
+         Float(Integer(std::llround(guess * 1E18L)),
+               -18 - half, GuessDigits + 2), digits, true));
+
+      res.setPrecision(x.getPrecision());
+      return res;
+    }
+
+    /* y ^ n, for n > 0, by squaring. */
+   static Float power (const Float & y, unsigned long n)
+    {
+      Float res (Integer(1), 0, y.getPrecision()), square (y);
+
+      for (;;)
+       {
+         if ((n & 1) != 0) res *= square;
+         n >>= 1;
+         if (n == 0) break;
+         square = sqr(square);
+       }
+
+      return res;
+    }
+
+    /*
+      x ^ (-1 / n) by Newton's method, y' = y + y * (1 - x * y ^ n) / n,
+      and then x ^ (1 / n) = x * y ^ (n - 1).
+    */
+   Float root (const Float & x, unsigned long n)
+    {
+      if (n < 2) return x;
+      if (!x.isUnSpecial() || x.isSigned()) return sqrtOfSpecial(x);
+
+      unsigned long digits = x.getPrecision() + NewtonExtra;
+      long double lead = leadingDigits(x);
+      long whole = x.exponent() / (long)n, rest = x.exponent() % (long)n;
+
+         //The exponent is whole * n + rest, with 0 <= rest < n.
+      if (rest < 0)
+       {
+         rest += (long)n;
+         whole--;
+       }
+
+      long double guess = std::pow(lead, -1.0L / n) *
+                          std::pow(10.0L, -(long double)rest / n);
+
+      Float y (Integer(std::llround(guess * 1E18L)), -18 - whole,
+               GuessDigits + 2);
+
+      unsigned long steps [64], count = 0;
+      for (unsigned long q = digits; q > GuessDigits; q = q / 2 + 2)
+         steps[count++] = q;
+
+      Float fraction (recip(Float(Integer((long)n), 0, digits)));
+      while (count != 0)
+       {
+         unsigned long q = steps[--count];
+         Float xq (x), error (Integer(1), 0, q);
+
+         xq.setPrecision(q);
+         y.setPrecision(q);
+         error -= xq * power(y, n);
+         y += y * (error * fraction);
+       }
+
+      Float res (x);
+      res.setPrecision(digits);
+      res *= power(y, n - 1);
+
+      res.setPrecision(x.getPrecision());
+      return res;
+    }
+
    Float operator / (const Float & lhs, const Float & rhs)
+    {
+      return Float(lhs) / rhs;
+    }
+
+   Float operator / (Float && lhs, const Float & rhs)
     {
       Float temp;
 
@@ -620,8 +1176,10 @@ namespace BigInt
        }
       else
        {
+         if (Float::fastDivide(lhs, rhs, temp)) return temp;
+
             //Do the divide
-         temp.Data = lhs.Data / rhs.Data;
+         temp.Data = std::move(lhs.Data) / rhs.Data;
          temp.Exponent = lhs.Exponent - rhs.Exponent;
 
             //Normalize
@@ -807,6 +1365,22 @@ namespace BigInt
        }
       else
        {
+            //Skip nearly all of the leading zeros at once: the scaled
+            //Integer has fewer than (msb + 1) * log10(2) + 1 digits.
+         long skip = (long)Data.getPrecision() - 1 -
+            (long)((double)(Data.msb() + 1) * 0.30102999566398120);
+         if (skip > 0)
+          {
+            if ((Exponent - skip) < minExponent)
+             {
+               Exponent = 0;
+               Data = Fixed(0, minPrecision);
+               return *this;
+             }
+            Data.setPrecision(Data.getPrecision() - (unsigned long)skip);
+            Exponent -= skip;
+          }
+
          while (Data.compare(lower) < 0)
           {
             Data.setPrecision(Data.getPrecision() - 1);
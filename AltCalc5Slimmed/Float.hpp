@@ -72,11 +72,21 @@ namespace BigInt
 
          void precisionChanger (unsigned long newPrecision);
 
+            //The operators at small precisions, in native integers:
+            //these return false when they can't be used.
+         static bool fastAdd (const Float &, const Float &, bool, Float &);
+         static bool fastMultiply (const Float &, const Float &, Float &);
+         static bool fastDivide (const Float &, const Float &, Float &);
+
       public:
 
          Float (const Float & from) :
             Data (from.Data), Sign (from.Sign), Exponent (from.Exponent),
             Infinity (from.Infinity), NaN (from.NaN) { }
+         Float (Float && from) :
+            Data (std::move(from.Data)), Sign (from.Sign),
+            Exponent (from.Exponent), Infinity (from.Infinity),
+            NaN (from.NaN) { }
          Float () :
             Data (0, minPrecision), Sign (false), Exponent(0),
             Infinity (false), NaN (0)
@@ -85,6 +95,16 @@ namespace BigInt
          Float (const char *);
          ~Float () { /* This has nothing to do. */ }
 
+          /*
+            For the functions that work with exact integers: the first makes
+            mantissa * 10 ^ exponent, rounded to precision digits, and
+            toInteger is the inverse, this * 10 ^ -exponent rounded to an
+            Integer.
+          */
+         Float (const Integer & mantissa, long exponent,
+                unsigned long precision);
+         Integer toInteger (long exponent) const;
+
          unsigned long getPrecision (void) const
           { return Data.getPrecision(); }
          unsigned long setPrecision (unsigned long newPrecision)
@@ -132,13 +152,14 @@ namespace BigInt
          Float & setSign (bool toThis)
             { Sign = toThis; return *this; }
 
-         friend Float operator + (const Float &, const Float &);
-         friend Float operator - (const Float &, const Float &);
-         friend Float operator * (const Float &, const Float &);
-         friend Float operator / (const Float &, const Float &);
+         friend Float operator + (Float &&, const Float &);
+         friend Float operator - (Float &&, const Float &);
+         friend Float operator * (Float &&, const Float &);
+         friend Float operator / (Float &&, const Float &);
 
          Float operator - (void) const
-          { Float returnedFloat(*this); return returnedFloat.negate(); }
+          { Float returnedFloat(*this); returnedFloat.negate();
+            return returnedFloat; }
          bool operator ! (void) const { return isZero(); }
 
           /*
@@ -158,6 +179,7 @@ namespace BigInt
 
             // Structure preserving assignment
          Float & operator = (const Float &);
+         Float & operator = (Float &&);
             // Data type preserving assignment
          Float & operator |= (const Float &);
 
@@ -170,11 +192,36 @@ namespace BigInt
          Float & normalize (void);
 
          friend Float sqrt (const Float &);
-         friend Float exp (const Float &);
+         friend Float sqrtOfSpecial (const Float &);
          friend Float log (const Float &);
+            //The workers behind exp and log: see Ziv's loop in Functions.cpp
+         friend Float expAt (const Float &, unsigned long);
+         friend Float logAt (const Float &, unsigned long);
+
+            //Converts to and from Floats: see FixedFloat.hpp
+         template <unsigned long> friend class FixedPrecisionFloat;
 
     }; /* class Float */
 
+   Float operator + (const Float &, const Float &);
+   Float operator + (Float &&, const Float &);
+   Float operator - (const Float &, const Float &);
+   Float operator - (Float &&, const Float &);
+   Float operator * (const Float &, const Float &);
+   Float operator * (Float &&, const Float &);
+   Float operator / (const Float &, const Float &);
+   Float operator / (Float &&, const Float &);
+
+   Float sqr (const Float &);
+
+    /*
+      1 / x, 1 / sqrt(x) and x ^ (1 / n), by Newton's method from a long
+      double guess, doubling the precision with each step.
+    */
+   Float recip (const Float &);
+   Float rsqrt (const Float &);
+   Float root (const Float &, unsigned long);
+
    bool operator > (const Float &, const Float &);
    bool operator < (const Float &, const Float &);
    bool operator >= (const Float &, const Float &);
@@ -215,6 +262,22 @@ namespace BigInt
 
    Float atan2 (const Float &, const Float &);
 
+    /*
+      The functions marked with * other than sqrt are correctly rounded, as
+      is pow with an integer exponent or one that is exactly 1 / n. These
+      count how many times one was evaluated, and how many of those had to
+      be evaluated again with more digits to decide the rounding, and how
+      many came out exact, which no number of digits would decide.
+    */
+   extern unsigned long ZIVCALLS;
+   extern unsigned long ZIVRETRIES;
+   extern unsigned long ZIVEXACT;
+
+    /*
+      How many +, -, * and / were done by the native integer fast paths.
+    */
+   extern unsigned long FASTPATHHITS;
+
  } /* namespace BigInt */
 
 #endif /* FLOAT_HPP */
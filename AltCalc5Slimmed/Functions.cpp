@@ -17,6 +17,9 @@
    You should have received a copy of the GNU General Public License
    along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
+#include <string>
+#include <vector>
+
 #include "Float.hpp"
 #include "Constants.hpp"
 
@@ -26,6 +29,15 @@ namespace BigInt
 
 	unsigned long SERIESEXTRA = 8;
 	unsigned long DERIVEDEXTRA = 4;
+	unsigned long TRIGSPLITPRECISION = 100;
+	unsigned long SPLITSTART = 8;
+	unsigned long AGMPRECISION = 250;
+	unsigned long ZIVEXTRA = 6;
+	unsigned long ZIVLOSS = 2;
+	unsigned long ZIVCALLS = 0;
+	unsigned long ZIVRETRIES = 0;
+	unsigned long ZIVEXACT = 0;
+	unsigned long POWWINDOW = 4;
 
 /*
 ==============================================================================
@@ -38,8 +50,29 @@ namespace BigInt
 
       Newton-Rhapson is much faster than x ^ .5,
       which becomes e ^ (.5 * ln(x)).
+      sqrt(x) = x * rsqrt(x). rsqrt doubles its precision with each step,
+      so all of it costs a few multiplies at full precision, where the
+      old loop did a full precision divide on every step.
+
+      That is only close. It is cut to two more digits than asked
+      for, and moved until its square is no more than x and the next one
+      up's is more. A nonzero digit is put after it if its square isn't x,
+      and it is rounded once: exact roots stay exact in every round mode.
 ==============================================================================
 */
+    /* Compares (m * 10 ^ e) ^ 2 with a * 10 ^ ae. */
+   static int compareSquare (const Integer & m, long e,
+                             const Integer & a, long ae)
+    {
+      Integer square (sqr(m)), other (a);
+      long shift = 2 * e - ae;
+
+      if (shift >= 0) square *= Fixed::powerOfTen((unsigned long)shift);
+      else other *= Fixed::powerOfTen((unsigned long)-shift);
+
+      return square.compare(other);
+    }
+
    Float sqrt (const Float & opp)
     {
       Float copyOpp (opp);
@@ -54,31 +87,464 @@ namespace BigInt
       if (opp.isNaN() || opp.isInfinity()) return opp;
 
       copyOpp.setPrecision(opp.getPrecision() + SERIESEXTRA);
+      copyOpp *= rsqrt(copyOpp);
+
+      unsigned long precision = opp.getPrecision();
+      long ae = opp.exponent() - (long)precision;
+      long e = copyOpp.exponent() - (long)(precision + 2);
+      Integer a (opp.toInteger(ae)), m (copyOpp.toInteger(e));
+
+      while (compareSquare(m + Integer(1), e, a, ae) <= 0) m += Integer(1);
+      while (compareSquare(m, e, a, ae) > 0) m -= Integer(1);
+
+      m = m * Integer(10) +
+         Integer((compareSquare(m, e, a, ae) == 0) ? 0 : 1);
+      return Float(m, e - 1, precision);
+    }
+
+/*
+==============================================================================
+   Function: series coefficients (source file scope only)
+------------------------------------------------------------------------------
+   NOTES:
+      The term-by-term loops for sin and cos multiply by 1 / n! rather
+      than divide by n!. Each coefficient is one exact factorial divided
+      out once, to the precision asked for, and then kept. A program that
+      calls these functions over and over at the same precision only ever
+      pays for the first call.
+
+      There is one table per thread: Integer isn't thread safe. A different
+      precision starts the table over, and a longer series extends it.
+==============================================================================
+*/
+   static thread_local std::vector<Float> recipFactorials;
+   static thread_local std::vector<Integer> factorials;
+   static thread_local unsigned long coefficientPrecision = 0;
+
+   static void checkCoefficients (unsigned long precision)
+    {
+      if (precision == coefficientPrecision) return;
+
+      recipFactorials.clear();
+      coefficientPrecision = precision;
+    }
 
-      long diff, term = opp.getPrecision() + DERIVEDEXTRA;
+    /* 1 / n! */
+   static const Float & recipFactorial (unsigned long n,
+                                        unsigned long precision)
+    {
+      checkCoefficients(precision);
+      if (factorials.empty()) factorials.push_back(Integer(1));
 
-      Float temp (copyOpp);
-      Float curApprox (copyOpp);
-      Float lastApprox (copyOpp);
+      while (factorials.size() <= n)
+         factorials.push_back(factorials.back() *
+                              Integer((long)factorials.size()));
 
-         //This helps to produce a good first estimate, and is why
-         //this function has to be a friend.
-      curApprox.Exponent /= 2;
-      do
+      while (recipFactorials.size() <= n)
        {
-         lastApprox = curApprox;
+         Float one (Integer(1), 0, precision);
+         recipFactorials.push_back(one /
+            Float(factorials[recipFactorials.size()], 0, precision));
+       }
 
-         curApprox = (curApprox * curApprox + copyOpp) / (curApprox + curApprox);
+      return recipFactorials[n];
+    }
 
-         temp = curApprox - lastApprox;
+/*
+==============================================================================
+   Function: binary splitting (source file scope only)
+------------------------------------------------------------------------------
+   NOTES:
+      Summed term by term, every term of a series costs a divide at full
+      precision. Binary splitting (Haible and Papanikolaou, "Fast
+      Multiprecision Evaluation of Series of Rational Numbers") sums it
+      exactly instead. For the terms
+         t(1) = p(1) / q(1),   t(n) = t(n - 1) * p(n) / q(n)
+      split finds, for the terms a to b - 1, the products P of the p's and
+      Q of the q's, and a T such that T / Q is their sum. The two halves of
+      a range are put together as
+         P = P1 * P2,   Q = Q1 * Q2,   T = T1 * Q2 + P1 * T2
+      and there is only one division, at the very end. When p and q are
+      small, this is quasi-linear in the cost of a multiplication.
+
+      An argument with many digits doesn't give a small p, so it is cut into
+      pieces (Brent's "bit-burst"): the first SPLITSTART significant digits,
+      then the next that many, then twice that, and so on. Each piece has
+      about as many leading zeros as it has digits, so the terms of its
+      series shrink as fast as their numbers grow. The pieces are put back
+      together with exp(a + b) = exp(a) * exp(b), the angle sum formulas,
+      and atan(x) = atan(a) + atan((x - a) / (1 + x * a)).
+
+      Even with the small argument reductions done before them, splitting
+      was no slower for exp and atan at any precision tried (down to four
+      digits), so they always split. Once their coefficients are cached,
+      the term-by-term loops for sin and cos are faster up to about a
+      hundred digits, so those split from TRIGSPLITPRECISION digits.
+==============================================================================
+*/
+   enum Series { EXP_SERIES, SIN_SERIES, COS_SERIES, ATAN_SERIES };
 
-         diff = curApprox.Exponent - temp.Exponent;
-         if (diff < 0) diff = -diff;
+   struct Split
+    {
+      Integer P, Q, T;
+    };
+
+    /*
+      The ratio of term n to the one before it. For exp, x / scale is the
+      piece, and for the rest, it is the piece squared.
+    */
+   static void splitTerm (Split & term, Series kind, long n,
+                          const Integer & x, const Integer & scale)
+    {
+      switch (kind)
+       {
+         case EXP_SERIES: // x / n
+            term.P = x;
+            term.Q = scale * Integer(n);
+            break;
+         case SIN_SERIES: // -x^2 / (2n * (2n + 1))
+            term.P = -x;
+            term.Q = scale * Integer(2 * n * (2 * n + 1));
+            break;
+         case COS_SERIES: // -x^2 / ((2n - 1) * 2n)
+            term.P = -x;
+            term.Q = scale * Integer((2 * n - 1) * 2 * n);
+            break;
+         case ATAN_SERIES: // -x^2 * (2n - 1) / (2n + 1)
+            term.P = x * Integer(1 - 2 * n);
+            term.Q = scale * Integer(2 * n + 1);
+            break;
+       }
+      term.T = term.P;
+    }
+
+    /* P is only needed for the left half of a range. */
+   static void split (Split & res, Series kind, long a, long b,
+                      const Integer & x, const Integer & scale, bool needP)
+    {
+      if (b - a == 1)
+       {
+         splitTerm(res, kind, a, x, scale);
+         return;
        }
-      while ((diff <= term) && !temp.isZero());
 
-      curApprox.setPrecision(opp.getPrecision());
-      return curApprox;
+      Split right;
+      long mid = (a + b) / 2;
+
+      split(res, kind, a, mid, x, scale, true);
+      split(right, kind, mid, b, x, scale, needP);
+
+      res.T = res.T * right.Q + res.P * right.T;
+      res.Q *= right.Q;
+      if (needP) res.P *= right.P;
+    }
+
+    /*
+      The number of terms needed for digits digits, for a piece less
+      than 10 ^ lead.
+    */
+   static long splitTerms (Series kind, long lead, unsigned long digits)
+    {
+      double scale = 1.0; // The term is about scale * 10 ^ size.
+      long size = 0, n = 0;
+
+      while (size >= -(long)digits)
+       {
+         n++;
+         switch (kind)
+          {
+            case EXP_SERIES:
+               size += lead;
+               scale /= (double)n;
+               break;
+            case SIN_SERIES:
+               size += 2 * lead;
+               scale /= (double)(2 * n * (2 * n + 1));
+               break;
+            case COS_SERIES:
+               size += 2 * lead;
+               scale /= (double)((2 * n - 1) * 2 * n);
+               break;
+            case ATAN_SERIES:
+               size += 2 * lead;
+               break;
+          }
+         while (scale < 0.1)
+          {
+            scale *= 10.0;
+            size--;
+          }
+       }
+
+      return n;
+    }
+
+    /*
+      The series for the piece x / 10 ^ digits, which is less than
+      10 ^ lead, to precision digits. This is 1 + T / Q. For sin and atan,
+      that is still to be multiplied by the piece.
+    */
+   static Float splitSum (Series kind, const Integer & x, unsigned long digits,
+                          long lead, unsigned long precision)
+    {
+      Integer num (x), scale (Fixed::powerOfTen(digits));
+      Split sum;
+
+      if (kind != EXP_SERIES)
+       {
+         num.square();
+         scale.square();
+       }
+
+      split(sum, kind, 1, splitTerms(kind, lead, precision) + 1, num, scale,
+            false);
+
+      return Float(sum.T + sum.Q, 0, precision) /
+             Float(sum.Q, 0, precision);
+    }
+
+    /*
+      Takes the next piece off of the front of rest, which has precision
+      digits after the decimal point. The piece is the digits up to the
+      to'th, and the next one will be twice as long.
+    */
+   static void nextPiece (Integer & rest, Integer & piece,
+                          unsigned long & to, unsigned long precision)
+    {
+      if (to > precision) to = precision;
+      Integer::divmod(rest, Fixed::powerOfTen(precision - to), piece, rest);
+    }
+
+    /* The first piece, of SPLITSTART significant digits of x. */
+   static unsigned long firstPiece (const Float & x)
+    {
+      return ((x.exponent() < 0) ? -x.exponent() - 1 : 0) + SPLITSTART;
+    }
+
+    /* exp(x) for 0 <= x < 1. */
+   static Float expSplit (const Float & x, unsigned long precision)
+    {
+      Integer rest (x.toInteger(-(long)precision)), piece;
+      Float res (Integer(1), 0, precision);
+      long lead = x.exponent() + 1;
+
+      for (unsigned long to = firstPiece(x); !rest.isZero(); to *= 2)
+       {
+         nextPiece(rest, piece, to, precision);
+         if (!piece.isZero())
+            res *= splitSum(EXP_SERIES, piece, to, lead, precision);
+         lead = -(long)to;
+       }
+
+      return res;
+    }
+
+    /* sin(x) and cos(x) for 0 <= x < 10. */
+   static void sinCosSplit (const Float & x, unsigned long precision,
+                            Float & s, Float & c)
+    {
+      Integer rest (x.toInteger(-(long)precision)), piece;
+      long lead = x.exponent() + 1;
+
+      s = Float(Integer(0), 0, precision);
+      c = Float(Integer(1), 0, precision);
+
+      for (unsigned long to = firstPiece(x); !rest.isZero(); to *= 2)
+       {
+         nextPiece(rest, piece, to, precision);
+         if (!piece.isZero())
+          {
+            Float pieceSin (piece, -(long)to, precision), pieceCos;
+
+            pieceSin *= splitSum(SIN_SERIES, piece, to, lead, precision);
+            pieceCos = splitSum(COS_SERIES, piece, to, lead, precision);
+
+            Float temp (s * pieceCos + c * pieceSin);
+            c = c * pieceCos - s * pieceSin;
+            s = temp;
+          }
+         lead = -(long)to;
+       }
+    }
+
+    /*
+      atan(x) for 0 < x < 1. It is first brought under 0.1 with
+         atan(x) = 2 * atan(x / (1 + sqrt(1 + x * x)))
+      so that the first series converges quickly.
+    */
+   static Float atanSplit (const Float & x, unsigned long precision)
+    {
+      Float one (Integer(1), 0, precision), y (x);
+      Float res (Integer(0), 0, precision);
+      int halvings = 0;
+
+      y.setPrecision(precision);
+      while (y.exponent() >= -1)
+       {
+         y = y / (one + sqrt(one + sqr(y)));
+         halvings++;
+       }
+
+      long lead = y.exponent() + 1;
+      for (unsigned long to = firstPiece(y); !y.isZero(); to *= 2)
+       {
+         if (to > precision) to = precision;
+
+         Integer piece (y.toInteger(-(long)to));
+         if (!piece.isZero())
+          {
+            Float pieceFloat (piece, -(long)to, precision);
+
+            res += pieceFloat * splitSum(ATAN_SERIES, piece, to, lead,
+                                         precision);
+            y = (y - pieceFloat) / (one + y * pieceFloat);
+          }
+         if (to == precision) break;
+         lead = -(long)to;
+       }
+
+      while (halvings--) res += res;
+
+      return res;
+    }
+
+/*
+==============================================================================
+   Function: Ziv's rounding test (source file scope only)
+------------------------------------------------------------------------------
+   NOTES:
+      The functions marked * are worked out to ZIVEXTRA more digits than
+      asked for, and the result is assumed good to all but the last
+      ZIVLOSS of those. If the digits past the rounding point are then
+      too close to a place where the rounding changes (all zeros, all
+      nines, or a half), the error could change how it rounds. Only then
+      is it worked out again, with twice as many extra digits. Otherwise,
+      rounding it gives the same as rounding the exact answer.
+
+      Results that really are exact would never pass. A zero is returned
+      as it is. So is a result with no digits past the precision, if the
+      evaluation before it gave the same one: a result that only looks
+      exact at one number of extra digits shows its error at the next.
+      Past that, after the extra digits pass four times the precision, it
+      is rounded anyway.
+
+      The assumed error is relative to the result. A worker whose error is
+      relative to something bigger, as sin and cos are to their reduced
+      argument, sets zivLost to how many digits bigger, and that many
+      fewer are taken as good.
+
+      None of these functions is exact but at the points they check for,
+      but near 0 they come within any number of digits of 1 or of their
+      argument: cos(x) is 1 - x * x / 2 and a bit. Workers return such a
+      short value as it is, and set zivTail to the sign of what they left
+      off, which is under a hundredth of its last place. It is then
+      rounded as if it had one more nonzero digit far past the precision.
+
+      ZIVCALLS counts the evaluations, ZIVRETRIES the ones that had to be
+      worked out again, and ZIVEXACT the ones returned as exact.
+==============================================================================
+*/
+   static thread_local unsigned long zivLost = 0;
+   static thread_local int zivTail = 0;
+
+    /* Is x so small that x * x is under 10 ^ -(precision + 3)? */
+   static bool tiny (const Float & x, unsigned long precision)
+    {
+      return 2 * (x.exponent() + 1) < -(long)(precision + 3);
+    }
+
+    /*
+      value, which has no more than precision + 1 digits, with a nonzero
+      digit added two places past them, toward up or down, and rounded.
+    */
+   static Float nudge (const Float & value, bool up, unsigned long precision)
+    {
+      Float res (value);
+      unsigned long digits = precision + 3;
+
+      res.setPrecision(digits);
+      long exponent = res.exponent() - (long)digits;
+      Integer last (res.toInteger(exponent));
+      last += Integer(up ? 1 : -1);
+
+      res = Float(last, exponent, digits);
+      res.setPrecision(precision);
+      return res;
+    }
+
+    /* The digits of x, less any trailing zeros. */
+   static unsigned long significantDigits (const Float & x)
+    {
+      Float copy (x);
+      std::string digits (copy.abs().toInteger(
+         copy.exponent() - (long)copy.getPrecision()).toString());
+
+      std::string::size_type last = digits.find_last_not_of('0');
+      return (last == std::string::npos) ? 1 : (unsigned long)(last + 1);
+    }
+
+   static bool canRound (const Float & res, unsigned long precision,
+                         unsigned long good)
+    {
+      Integer digits (res.toInteger(res.exponent() - (long)good)), high;
+      Integer scale (Fixed::powerOfTen(good - precision));
+      Integer error (2), half;
+
+      Integer::divmod(scale, Integer(2), half, high);
+      digits.abs();
+      Integer::divmod(digits, scale, high, digits); //Now what is past it.
+
+      return (digits.compare(error) > 0) &&
+             ((scale - digits).compare(error) > 0) &&
+             ((digits - half).abs().compare(error) > 0);
+    }
+
+   static Float ziv (Float (*at) (const Float &, unsigned long),
+                     const Float & opp)
+    {
+      unsigned long precision = opp.getPrecision();
+      Float res, last;
+
+      ZIVCALLS++;
+      for (unsigned long extra = ZIVEXTRA; ; extra *= 2)
+       {
+         zivLost = 0;
+         zivTail = 0;
+         res = at(opp, extra);
+         if (res.isZero())
+          {
+            ZIVEXACT++;
+            break;
+          }
+         if (zivTail != 0)
+          {
+            res = nudge(res, zivTail > 0, precision);
+            break;
+          }
+         if (!res.isUnSpecial() || ((ZIVLOSS + zivLost < extra) &&
+             canRound(res, precision, precision + extra - ZIVLOSS - zivLost)))
+            break;
+
+         if (significantDigits(res) <= precision)
+          {
+            Float shorter (res);
+            shorter.setPrecision(precision); //Changes no digits
+            if (last.isUnSpecial() && (shorter.compare(last) == 0))
+             {
+               ZIVEXACT++;
+               res = shorter;
+               break;
+             }
+            last = shorter;
+          }
+         else last = Float();
+
+         if (extra > 4 * (precision + ZIVEXTRA)) break;
+         ZIVRETRIES++;
+       }
+
+      res.setPrecision(precision);
+      return res;
     }
 
 /*
@@ -108,16 +574,17 @@ namespace BigInt
       multiplications (probably negligable) and if it really speeds things up.
 ==============================================================================
 */
-   Float exp (const Float & opp)
+   Float expAt (const Float & opp, unsigned long extra)
     {
       Float one (opp);
 
-      if (opp.isZero()) return (one |= M_1);
-      else if (opp.isNaN()) return opp;
-      else if (opp.isInfinity())
+      if (opp.exponent() + 1 < -(long)(opp.getPrecision() + 3))
        {
-         if (!opp.isSigned()) return opp;
-         return Float();
+          //exp(x) is 1 + x and a bit, and x is under a hundredth of an ulp.
+         one.setPrecision(opp.getPrecision() + extra);
+         one |= M_1;
+         zivTail = opp.isSigned() ? -1 : 1;
+         return one;
        }
 
        /*
@@ -128,52 +595,25 @@ namespace BigInt
       long loops = opp.Exponent + 3;
 
        /*
-         This is a bit arbitrary and is in need of explanation:
-         As written SERIESEXTRA is 8, and thus we add 16 digits
-         to the computation. In the "special" loop, we loose one
-         digit of accuracy for each iteration. This way, for very
-         large numbers, we can loose up to 10 digits, which leaves
-         us 6 for rounding.
+         In the "special" loop, we loose one digit of accuracy for each
+         iteration, so those are added to the extra digits.
        */
       if (special)
-         one.setPrecision(opp.getPrecision() + SERIESEXTRA * 2);
+         one.setPrecision(opp.getPrecision() + extra + loops);
       else
-         one.setPrecision(opp.getPrecision() + SERIESEXTRA);
+         one.setPrecision(opp.getPrecision() + extra);
       one |= M_1;
 
-      Float currentFactorial (one);
-      Float currentDivisor (one);
-      Float currentPower (one);
       Float copyOpp (one);
       Float res (one);
       Float temp (one);
 
-      currentFactorial |= Float("2");
-      currentDivisor |= Float("2");
-      currentPower |= opp;
       copyOpp |= opp;
 
-      currentPower.abs();
       copyOpp.abs();
-      if (special)
-       {
-         currentPower.Exponent = -3;
-         copyOpp.Exponent = -3;
-       }
-
-
-      res += currentPower;
-      currentPower *= copyOpp;
+      if (special) copyOpp.Exponent = -3;
 
-      temp = currentPower / currentDivisor;
-      while (change(temp, res))
-       {
-         res += temp;
-         currentFactorial += one;
-         currentDivisor *= currentFactorial;
-         currentPower *= copyOpp;
-         temp = currentPower / currentDivisor;
-       }
+      res = expSplit(copyOpp, one.getPrecision());
 
       if (special)
        {
@@ -184,16 +624,83 @@ namespace BigInt
          while (loops-- && !res.Infinity)
           {
             temp = res;
-            temp *= temp; //2
-            temp *= temp; //4
-            res *= temp;  //5
-            res *= res;   //10
+            temp = sqr(temp); //2
+            temp = sqr(temp); //4
+            res *= temp;      //5
+            res = sqr(res);   //10
           }
        }
 
       if (opp.isSigned()) res = one / res;
 
-      res.setPrecision(opp.getPrecision());
+      return res;
+    }
+
+   Float exp (const Float & opp)
+    {
+      Float one (opp);
+
+      if (opp.isZero()) return (one |= M_1);
+      else if (opp.isNaN()) return opp;
+      else if (opp.isInfinity())
+       {
+         if (!opp.isSigned()) return opp;
+         return Float();
+       }
+
+      return ziv(expAt, opp);
+    }
+
+/*
+==============================================================================
+   Function: AGM logarithm (source file scope only)
+------------------------------------------------------------------------------
+   NOTES:
+      From Brent and Salamin, for large s:
+         ln(s) = pi / (2 * AGM(1, 4 / s)) + O(ln(s) / s ^ 2)
+      where AGM is the arithmetic-geometric mean:
+         a' = (a + b) / 2,   b' = sqrt(a * b)
+      It takes about log2(digits) square roots, instead of a series whose
+      length grows with the digits.
+
+      s is x * 10 ^ k, with k chosen so that s has more than half as many
+      digits as the result, and then ln(x) = ln(s) - k * ln(10). That
+      subtraction cancels about as many digits as k has, and more when x is
+      near one and ln(x) is small, so those are carried as extra digits.
+
+      Above AGMPRECISION digits, log uses this instead of its series.
+==============================================================================
+*/
+   static Float agmLog (const Float & x, unsigned long precision)
+    {
+      unsigned long digits = precision;
+
+      Float diff (x - Float(Integer(1), 0, x.getPrecision()));
+      if (!diff.isZero() && (diff.exponent() < 0))
+         digits -= diff.exponent();
+
+      long k = (long)(digits / 2) + 2 - x.exponent();
+      for (long t = (k < 0) ? -k : k; t != 0; t /= 10) digits++;
+
+      Float half (Integer(5), -1, digits), a (Integer(1), 0, digits);
+      Float b (Float(Integer(4), -k, digits) / x);
+
+      for (;;)
+       {
+         diff = a - b;
+         if (diff.isZero() ||
+             (diff.exponent() < a.exponent() - (long)(digits / 2) - 1))
+            break;
+
+         Float mean ((a + b) * half);
+         b = sqrt(a * b);
+         a = mean;
+       }
+      a = (a + b) * half;
+
+      Float res (constant(CONST_PI_2, digits) / a -
+                 Float(Integer(k), 0, digits) * constant(CONST_LN10, digits));
+      res.setPrecision(precision);
       return res;
     }
 
@@ -234,20 +741,19 @@ namespace BigInt
       diminishing returns.
 ==============================================================================
 */
-   Float log (const Float & opp)
+   Float logAt (const Float & opp, unsigned long extra)
     {
       Float one (opp);
 
-      if (opp.isZero()) return -M_Inf;
-      if (opp.isSigned())
-       {
-         one = Float();
-         one.NaN = 16;
-         return one;
-       }
-      if (opp.isNaN() || opp.isInfinity()) return opp;
+         //ln(1) is exactly zero, which the AGM only comes near
+      one |= M_1;
+      if (opp.compare(one) == 0)
+         return Float(Integer(0), 0, opp.getPrecision() + extra);
+
+      if (opp.getPrecision() >= AGMPRECISION)
+         return agmLog(opp, opp.getPrecision() + extra);
 
-      one.setPrecision(opp.getPrecision() + SERIESEXTRA);
+      one.setPrecision(opp.getPrecision() + extra);
       one |= M_1;
 
       Float currentDivisor (one);
@@ -276,7 +782,7 @@ namespace BigInt
       else if (mode < 562341325) /* 177827941 .. 562341324 */
        {
          copyOpp.Exponent = 0;
-         temp |= M_1_SQRT10;
+         temp |= constant(CONST_1_SQRT10, temp.getPrecision());
          copyOpp *= temp;
          mode = 2;
        }
@@ -294,7 +800,7 @@ namespace BigInt
       res = currentPower;
       one |= Float("2");
 
-      copyOpp *= copyOpp;
+      copyOpp = sqr(copyOpp);
       currentPower *= copyOpp;
 
       temp = currentPower / currentDivisor;
@@ -312,14 +818,18 @@ namespace BigInt
          case 1:
             if (opp.Exponent == 0) break;
             temp |= Float(Integer(opp.Exponent).toString());
-            one |= M_LN10;
+            one |= constant(CONST_LN10, one.getPrecision());
 
             temp *= one; //which is now ln(10)
             res += temp;
             break;
-         case 2:
-            temp |= Float(Integer(opp.Exponent).toString() + ".5");
-            one |= M_LN10;
+         case 2: //For y < 0, y + .5 is -(-y - 1).5
+            if (opp.Exponent < 0)
+               temp |= Float("-" +
+                  Integer((-opp.Exponent - 1)).toString() + ".5");
+            else
+               temp |= Float(Integer(opp.Exponent).toString() + ".5");
+            one |= constant(CONST_LN10, one.getPrecision());
 
             temp *= one;
             res += temp;
@@ -327,17 +837,268 @@ namespace BigInt
          case 3:
             if (opp.Exponent == -1) break;
             temp |= Float(Integer(opp.Exponent + 1).toString());
-            one |= M_LN10;
+            one |= constant(CONST_LN10, one.getPrecision());
 
             temp *= one;
             res += temp;
             break;
        }
 
-      res.setPrecision(opp.getPrecision());
       return res;
     }
 
+   Float log (const Float & opp)
+    {
+      Float one (opp);
+
+      if (opp.isZero()) return -M_Inf;
+      if (opp.isSigned())
+       {
+         one = Float();
+         one.NaN = 16;
+         return one;
+       }
+      if (opp.isNaN() || opp.isInfinity()) return opp;
+
+      return ziv(logAt, opp);
+    }
+
+/*
+==============================================================================
+   Function: integer powers and roots (source file scope only)
+------------------------------------------------------------------------------
+   NOTES:
+      x ^ n, for an integer n, is worked out by multiplying, left to right
+      through the bits of n, POWWINDOW bits at a time: about one squaring
+      per bit, and one multiply per window, from a table of the odd powers
+      of x up to 2 ^ POWWINDOW - 1. Every one of those rounds once, and an
+      error made early on is raised to what is left of the power, so the
+      result is good to about ten ulps per operation, times n. As with the
+      functions under Ziv's test, that many more extra digits are carried,
+      and it is worked out again with more if it can't be rounded.
+
+      A power of a number with few digits is often exact, and then no
+      number of extra digits settles how it rounds. If the base has d
+      digits, not counting trailing zeros, its n-th power has at most
+      d * n, so if that isn't many more than are asked for, it is worked
+      out to all of them. For x ^ -n, 1 is then divided by all of them, and
+      only the quotient is rounded.
+
+      x ^ (1 / n) comes from root, which is good to an ulp. An exact root
+      fails the rounding test like an exact power, so when the test fails,
+      the rounded root is raised to the n-th power to see if it gives x
+      back.
+==============================================================================
+*/
+   static unsigned long lostDigits (unsigned long ops, unsigned long n)
+    {
+      unsigned long res = 0;
+      for (unsigned long unit = 1; 2 * unit < 10 * (ops + 1); unit *= 10)
+         res++;
+      for (; n >= 10; n /= 10) res++;
+      return res;
+    }
+
+    /* x ^ n, for n > 0, to precision digits. */
+   static Float windowPow (const Float & x, unsigned long n,
+                           unsigned long precision, unsigned long & ops)
+    {
+      Float base (x);
+      base.setPrecision(precision);
+
+      long top = 0;
+      while ((n >> top) > 1) top++;
+
+       /*
+         A window of w bits costs 2 ^ (w - 1) - 1 multiplies for its table,
+         and saves multiplies one in w + 1 bits.
+       */
+      unsigned long width = 1;
+      while ((width < POWWINDOW) && ((1UL << width) + (top + 1) / (width + 2)
+               < (1UL << (width - 1)) + (top + 1) / (width + 1)))
+         width++;
+
+      unsigned long largest = (1UL << width) - 1;
+      if (largest > n) largest = n;
+
+      std::vector<Float> odd (1, base); // x, x ^ 3, x ^ 5, ...
+      ops = 0;
+      if (largest > 2)
+       {
+         Float square (sqr(base));
+         ops++;
+         while (2 * odd.size() + 1 <= largest)
+          {
+            odd.push_back(odd.back() * square);
+            ops++;
+          }
+       }
+
+      Float res;
+      bool first = true;
+      for (long i = top; i >= 0; )
+       {
+         if (((n >> i) & 1) == 0)
+          {
+            res = sqr(res);
+            ops++;
+            i--;
+            continue;
+          }
+
+         long j = i - (long)width + 1;
+         if (j < 0) j = 0;
+         while (((n >> j) & 1) == 0) j++;
+
+         unsigned long bits = (n >> j) & ((2UL << (i - j)) - 1);
+         if (first)
+            res = odd[bits >> 1];
+         else
+          {
+            for (long k = j; k <= i; k++) res = sqr(res);
+            res *= odd[bits >> 1];
+            ops += (unsigned long)(i - j) + 2;
+          }
+         first = false;
+         i = j - 1;
+       }
+
+      return res;
+    }
+
+    /*
+      1 / x for an exact x, rounded once to precision digits: enough digits
+      of the quotient of the Integers, and a sticky digit for the rest.
+    */
+   static Float exactReciprocal (const Float & x, unsigned long precision)
+    {
+      long exponent = x.exponent() - (long)x.getPrecision();
+      unsigned long digits = x.getPrecision() + precision + 3;
+      Integer mantissa (x.toInteger(exponent)), q, r;
+      bool sign = mantissa.isSigned();
+
+      mantissa.abs();
+      Integer::divmod(Fixed::powerOfTen(digits), mantissa, q, r);
+      q = q * Integer(10) + Integer(r.isZero() ? 0 : 1);
+      if (sign) q = -q;
+
+      return Float(q, -exponent - (long)digits - 1, precision);
+    }
+
+   static Float integerPow (const Float & x, unsigned long n, bool invert)
+    {
+      unsigned long precision = x.getPrecision(), ops;
+      Float res, one;
+
+      if ((n <= precision + ZIVEXTRA) &&
+          (significantDigits(x) * n <= precision + ZIVEXTRA))
+       {
+         res = windowPow(x, n, significantDigits(x) * n, ops); //exact
+         if (invert) return exactReciprocal(res, precision);
+         res.setPrecision(precision);
+         return res;
+       }
+
+      ZIVCALLS++;
+      for (unsigned long extra = ZIVEXTRA + lostDigits(0, n); ; extra *= 2)
+       {
+         res = windowPow(x, n, precision + extra, ops);
+         if (invert)
+          {
+            one = res;
+            one |= M_1;
+            res = one / res;
+            ops++;
+          }
+
+         unsigned long lost = lostDigits(ops, n);
+         if (!res.isUnSpecial() || (extra > 4 * (precision + ZIVEXTRA)) ||
+             ((lost < extra) &&
+              canRound(res, precision, precision + extra - lost)))
+            break;
+         ZIVRETRIES++;
+       }
+
+      res.setPrecision(precision);
+      return res;
+    }
+
+   static Float rootPow (const Float & x, unsigned long n, bool invert)
+    {
+      unsigned long precision = x.getPrecision(), ops;
+      Float res, one;
+
+      ZIVCALLS++;
+      for (unsigned long extra = ZIVEXTRA; ; extra *= 2)
+       {
+         res = x;
+         res.setPrecision(precision + extra);
+         res = root(res, n);
+         ops = 2;
+
+         unsigned long lost = lostDigits(ops, 1);
+         if ((lost < extra) &&
+             canRound(res, precision, precision + extra - lost))
+            break;
+
+          /*
+            Is it exact? Then the rounded root, raised to the n-th power,
+            is x.
+          */
+         Float root (res);
+         root.setPrecision(precision);
+         if (significantDigits(root) * n <= 4 * (precision + ZIVEXTRA))
+          {
+            Float back (windowPow(root, n,
+                                  significantDigits(root) * n, ops));
+            if (back.compare(x) == 0)
+             {
+               res = root;
+               break;
+             }
+          }
+
+         if (extra > 4 * (precision + ZIVEXTRA)) break;
+         ZIVRETRIES++;
+       }
+
+      if (invert)
+       {
+         one = res;
+         one |= M_1;
+         res = one / res;
+       }
+
+      res.setPrecision(precision);
+      return res;
+    }
+
+    /*
+      If x is exactly 1 / n, for some integer n > 1, n. Otherwise, zero:
+      0.142857 isn't taken for 1 / 7, as x ^ 0.142857 isn't the 7th root.
+    */
+   static unsigned long reciprocalOf (const Float & x)
+    {
+      Float one (x), copy (x);
+
+      one |= M_1;
+      copy.abs();
+      if (!(copy < one)) return 0;
+
+      Float n (one / copy);
+      if (n.exponent() > 8) return 0;
+
+      Integer whole (n.toInteger(0));
+      if (whole.compare(Integer(1)) <= 0) return 0;
+
+         //whole has at most nine digits, so the product is exact.
+      copy.setPrecision(copy.getPrecision() + 9);
+      copy *= Float(whole, 0, copy.getPrecision());
+      if (copy.compare(one) != 0) return 0;
+
+      return (unsigned long)whole.toInt();
+    }
+
 /*
 ==============================================================================
    Function: exponentiation
@@ -358,6 +1119,9 @@ namespace BigInt
       would have to rationalize the fractional part and decide if that
       exponent is real, however this implies that the rational part is
       precise, which is incorrect for most purposes.
+
+      An integer exponent of up to nine digits, or one that is exactly
+      1 / n, takes the paths above instead, and is rounded correctly.
 ==============================================================================
 */
    Float pow (const Float & left, const Float & right)
@@ -376,6 +1140,17 @@ namespace BigInt
 
       if (left.isSigned() && !right.isInteger()) return sqrt(-M_1);
 
+      if (left.isUnSpecial() && right.isUnSpecial())
+       {
+         if (right.isInteger() && (right.exponent() <= 8))
+            return integerPow(base,
+               (unsigned long)exponent.toInteger(0).abs().toInt(),
+               right.isSigned());
+
+         unsigned long n = left.isSigned() ? 0 : reciprocalOf(exponent);
+         if (n != 0) return rootPow(base, n, right.isSigned());
+       }
+
       res.setPrecision(base.getPrecision());
 
       base.setPrecision(base.getPrecision() + DERIVEDEXTRA);
@@ -401,163 +1176,299 @@ namespace BigInt
    NOTES:
       Reduce for sine and cosine.
 
-      This doesn't produce accurate results for numbers with great magnitude.
-      One needs exponent extra digits of precision to get the correct
-      accuracy.
+      This is Payne and Hanek's reduction, in base ten. The argument is
+      M * 10 ^ k, for an integer M of precision + 1 digits, and what is
+      wanted is the fraction part of M * 10 ^ k / (2 * pi). The digits of
+      1 / (2 * pi) down to 10 ^ -k only ever add integers to that, and the
+      digits far enough past it don't reach the digits wanted. So the
+      fraction is a window of G digits of 1 / (2 * pi), starting at the
+      (k + 1)th, times M, mod 10 ^ G. Its cost depends on the precision, not
+      on how big the argument is.
+
+      Four times the fraction, less the nearest integer q, is the argument
+      less q * pi / 2, over pi / 2: what is left is in [-pi / 4, pi / 4],
+      and q mod 4 says which of +-sin and +-cos of it is wanted. Only
+      arguments past pi / 4 are reduced.
+
+      The window is taken from a string of the digits of 1 / (2 * pi), kept
+      for each thread and made longer when an argument needs more of them.
+      That is the only cost that grows with the argument, and it is paid
+      once.
+
+      If the argument is close to a multiple of pi / 2, four times the
+      fraction is close to an integer, what is left of it has leading
+      zeros, and the window is made longer by that many digits. So what
+      is returned is good to its own precision however much cancelled.
 ==============================================================================
 */
-   static void reduce (Float & arg)
+   static thread_local std::string recip2PiDigits;
+
+    /*
+      The count digits of 1 / (2 * pi) after the first digits after the
+      decimal point.
+    */
+   static std::string recip2Pi (unsigned long first, unsigned long count)
     {
-      Fixed_Round_Mode temp;
+      if (recip2PiDigits.size() < first + count)
+       {
+         unsigned long length = 2 * recip2PiDigits.size();
+         if (length < first + count) length = first + count;
+
+          /*
+            The constant is rounded, so take some more digits than are
+            kept, and throw them away.
+          */
+         Float digits (constant(CONST_1_2PI, length + 10));
+         recip2PiDigits = digits.toInteger(-(long)(length + 10)).toString();
+         recip2PiDigits.resize(length);
+       }
 
-      temp = Fixed::getRoundMode();
-      Fixed::setRoundMode(ROUND_ZERO);
+      return recip2PiDigits.substr(first, count);
+    }
+
+    /*
+      Replaces arg, which must not be negative, with arg - q * pi / 2 for
+      the nearest integer q, and returns q mod 4.
+    */
+   static unsigned long reduce (Float & arg)
+    {
+      unsigned long prec = arg.getPrecision();
+      Float quarterPi (arg);
 
-      Float twopi (arg), oneovertwopi (arg), res (arg), tempf (arg);
-      unsigned long prec = res.getPrecision();
+      quarterPi |= constant(CONST_PI_4, prec);
+      if (arg < quarterPi) return 0;
 
-      twopi |= M_2PI;
-      oneovertwopi |= M_1_2PI;
-      tempf.setPrecision(tempf.getPrecision() * 2);
+      long k = arg.exponent() - (long)prec;
+      Integer M (arg.toInteger(k)), scale, high, low, quadrant;
+      unsigned long G = 2 * prec + 12;
+      Float res;
 
-      for (int loops = 0; (loops < 64) && (arg > twopi); loops++)
+      for (;;)
        {
-         res = arg * oneovertwopi;
-         res.setPrecision(res.exponent());
-         res.setPrecision(prec);
+         std::string window;
 
-         tempf |= res;
-         tempf = arg - (tempf * twopi);
-         arg |= tempf;
-       }
+         if (k < 0) //The digits before the decimal point are all zero.
+          {
+            window.assign((unsigned long)-k, '0');
+            window += recip2Pi(0, G + k);
+          }
+         else
+            window = recip2Pi((unsigned long)k, G);
 
-      if (arg > twopi)
-       {
-         arg *= oneovertwopi;
-         res = arg;
-         res.setPrecision(res.exponent());
-         res.setPrecision(prec);
-         arg -= res;
-         arg *= twopi;
+         scale = Fixed::powerOfTen(G);
+         Integer::divmod(M * Integer(window) * Integer(4), scale, high, low);
+         if ((low * Integer(2)).compare(scale) > 0)
+          {
+            low -= scale;
+            high += Integer(1);
+          }
+
+         res = Float(low, -(long)G, prec);
+
+          /*
+            The last prec + 2 digits of low may be wrong: are there enough
+            before them?
+          */
+         long good = (long)G + res.exponent() + 1 - (long)(prec + 2);
+         if (res.isZero())
+            G += prec + 10;
+         else if (good < (long)prec + 1)
+            G += (unsigned long)((long)prec + 1 - good) + 10;
+         else
+            break;
        }
 
-      Fixed::setRoundMode(temp);
+      Integer::divmod(high, Integer(4), high, quadrant);
+      arg = res * constant(CONST_PI_2, prec);
+
+      return (unsigned long)quadrant.toInt();
     }
 
 /*
 ==============================================================================
-   Function: sine of an angle in radians
+   Function: sine and cosine of an angle in radians
 ------------------------------------------------------------------------------
    NOTES:
-      An implementation of the Maclaurin series for sine.
+      Implementations of the Maclaurin series for sine and cosine, for
+      arguments reduced to [-pi / 4, pi / 4]. With q from the reduction,
+         sin(x) = sin(r), cos(r), -sin(r), -cos(r)
+      for q = 0, 1, 2, 3, and cos(x) is sin(x + pi / 2), which is one
+      quadrant on.
+
+      The error of the result is relative to the reduced argument, and
+      the result can have fewer leading digits than that has. Those
+      digits are taken off of what Ziv's test counts as good, through
+      zivLost.
 ==============================================================================
 */
-   Float sin (const Float & opp)
+    /* sin(x) for |x| <= pi / 4, to the precision of x. */
+   static Float sinOctant (const Float & x)
     {
-      Float one (opp);
+      unsigned long precision = x.getPrecision();
+      Float copyOpp (x);
+      Float res;
 
-      if (opp.isNaN()) return opp;
-      if (opp.isInfinity()) return sqrt(-M_1);
+      copyOpp.abs(); //We will replace the sign later.
 
-      one.setPrecision(opp.getPrecision() + SERIESEXTRA);
-      one |= M_1;
+      if (precision >= TRIGSPLITPRECISION)
+       {
+         Float unused;
+         unsigned long digits = precision;
 
-      Float currentFactorial (one);
-      currentFactorial |= Float("3");
-      Float currentDivisor (one);
-      currentDivisor |= Float("6");
+         if (copyOpp.exponent() < 0) digits -= copyOpp.exponent();
+         sinCosSplit(copyOpp, digits, res, unused);
+       }
+      else
+       {
+         Float currentPower (copyOpp);
+         Float temp;
+         unsigned long n = 3;
 
-      Float temp (one);
-      Float copyOpp (one);
+         res = copyOpp;
+         copyOpp = sqr(copyOpp);
+         currentPower *= copyOpp;
 
-      copyOpp |= opp;
-      reduce(copyOpp.abs()); //We will replace the sign later.
+         bool alt = true;
+         temp = currentPower * recipFactorial(n, precision);
+         while (change(temp, res))
+          {
+            if (alt) res -= temp;
+            else res += temp;
+            alt = !alt;
+
+            n += 2;
+            currentPower *= copyOpp;
+
+            temp = currentPower * recipFactorial(n, precision);
+          }
+       }
+
+      if (x.isSigned()) res.negate(); //Sign replaced.
+
+      return res;
+    }
+
+    /* cos(x) for |x| <= pi / 4, to the precision of x. */
+   static Float cosOctant (const Float & x)
+    {
+      unsigned long precision = x.getPrecision();
+      Float copyOpp (x);
+      Float res (x);
+
+      copyOpp.abs(); //cos is symmetric about 0.
+      res |= M_1;
+
+      if (precision >= TRIGSPLITPRECISION)
+       {
+         Float unused;
+
+         sinCosSplit(copyOpp, precision, unused, res);
+
+         return res;
+       }
 
       Float currentPower (copyOpp);
-      Float res (copyOpp);
+      Float temp;
+      unsigned long n = 2;
 
-      copyOpp *= copyOpp;
       currentPower *= copyOpp;
+      copyOpp = sqr(copyOpp);
 
       bool alt = true;
-      temp = currentPower / currentDivisor;
+      temp = currentPower * recipFactorial(n, precision);
       while (change(temp, res))
        {
          if (alt) res -= temp;
          else res += temp;
          alt = !alt;
 
-         currentFactorial += one;
-         currentDivisor *= currentFactorial;
-         currentFactorial += one;
-         currentDivisor *= currentFactorial;
-
+         n += 2;
          currentPower *= copyOpp;
 
-         temp = currentPower / currentDivisor;
+         temp = currentPower * recipFactorial(n, precision);
        }
 
-      if (opp.isSigned()) res.negate(); //Sign replaced.
-
-      res.setPrecision(opp.getPrecision());
       return res;
     }
 
-/*
-==============================================================================
-   Function: cosine of an angle in radians
-------------------------------------------------------------------------------
-   NOTES:
-      An implementation of the Maclaurin series for cosine.
-==============================================================================
-*/
-   Float cos (const Float & opp)
+    /* sin(opp) for cosine false, and cos(opp) for cosine true. */
+   static Float sinCos (const Float & opp, unsigned long extra, bool cosine)
     {
-      Float one (opp);
+      Float copyOpp (opp), res;
 
-      if (opp.isNaN()) return opp;
-      if (opp.isInfinity()) return sqrt(-M_1);
+      copyOpp.setPrecision(opp.getPrecision() + extra);
+      copyOpp.abs();
 
-      one.setPrecision(opp.getPrecision() + SERIESEXTRA);
-      one |= M_1;
+      unsigned long quadrant = reduce(copyOpp) + (cosine ? 1 : 0);
+      if (quadrant & 1)
+       {
+          //cos(r) is 1 - r * r / 2 and a bit.
+         if (tiny(copyOpp, opp.getPrecision()))
+          {
+            res = copyOpp;
+            res |= M_1;
+            zivTail = -1;
+          }
+         else
+            res = cosOctant(copyOpp);
+       }
+      else
+       {
+          //sin(x) is x - x ^ 3 / 6 and a bit, if x wasn't reduced.
+         if (tiny(opp, opp.getPrecision()))
+          {
+            res = copyOpp;
+            zivTail = -1;
+          }
+         else
+            res = sinOctant(copyOpp);
+       }
 
-      Float currentFactorial (one);
-      currentFactorial |= Float("2");
-      Float currentDivisor (one);
-      currentDivisor |= Float("2");
+      if (res.isUnSpecial() && copyOpp.isUnSpecial() &&
+          (copyOpp.exponent() > res.exponent()))
+         zivLost = (unsigned long)(copyOpp.exponent() - res.exponent());
 
-      Float temp (one);
-      Float copyOpp (one);
+      if (quadrant & 2)
+       {
+         res.negate();
+         zivTail = -zivTail;
+       }
+      if (!cosine && opp.isSigned())
+       {
+         res.negate();
+         zivTail = -zivTail;
+       }
 
-      copyOpp |= opp; //We don't need to replace the sign as
-      reduce(copyOpp.abs()); //cos is symmetric about 0.
+      return res;
+    }
 
-      Float currentPower (copyOpp);
-      Float res (one);
+   static Float sinAt (const Float & opp, unsigned long extra)
+    {
+      return sinCos(opp, extra, false);
+    }
 
-      currentPower *= copyOpp;
-      copyOpp *= copyOpp;
+   Float sin (const Float & opp)
+    {
+      if (opp.isNaN()) return opp;
+      if (opp.isInfinity()) return sqrt(-M_1);
 
-      bool alt = true;
-      temp = currentPower / currentDivisor;
-      while (change(temp, res))
-       {
-         if (alt) res -= temp;
-         else res += temp;
-         alt = !alt;
+      return ziv(sinAt, opp);
+    }
 
-         currentFactorial += one;
-         currentDivisor *= currentFactorial;
-         currentFactorial += one;
-         currentDivisor *= currentFactorial;
+   static Float cosAt (const Float & opp, unsigned long extra)
+    {
+      return sinCos(opp, extra, true);
+    }
 
-         currentPower *= copyOpp;
+   Float cos (const Float & opp)
+    {
+      Float one (opp);
 
-         temp = currentPower / currentDivisor;
-       }
+      if (opp.isZero()) return (one |= M_1);
+      if (opp.isNaN()) return opp;
+      if (opp.isInfinity()) return sqrt(-M_1);
 
-      res.setPrecision(opp.getPrecision());
-      return res;
+      return ziv(cosAt, opp);
     }
 
 /*
@@ -577,10 +1488,13 @@ namespace BigInt
 
       copyOpp.setPrecision(opp.getPrecision() + DERIVEDEXTRA);
 
-      reduce(copyOpp.abs()); //Reduce only once.
-      if (opp.isSigned()) copyOpp.negate();
+      copyOpp.abs();
+      unsigned long quadrant = reduce(copyOpp); //Reduce only once.
 
-      copyOpp = sin(copyOpp) / cos(copyOpp);
+         //tan(r + pi / 2) = -cos(r) / sin(r)
+      if (quadrant & 1) copyOpp = -cos(copyOpp) / sin(copyOpp);
+      else copyOpp = sin(copyOpp) / cos(copyOpp);
+      if (opp.isSigned()) copyOpp.negate();
 
       copyOpp.setPrecision(opp.getPrecision());
       return copyOpp;
@@ -602,89 +1516,66 @@ namespace BigInt
       Both will be derived from atan.
 ==============================================================================
 */
-   Float atan (const Float & opp)
+   static Float atanAt (const Float & opp, unsigned long extra)
     {
       Float one (opp);
 
-      if (opp.isZero()) return one;
-      if (opp.isNaN()) return opp;
-      if (opp.isInfinity())
-       {
-         if (opp.isSigned()) return (one |= -M_PI_2);
-         return (one |= M_PI_2);
-       }
-
-      one.setPrecision(one.getPrecision() + SERIESEXTRA);
+      one.setPrecision(one.getPrecision() + extra);
       one |= M_1;
 
-      Float currentFactor (one);
-      currentFactor |= Float("3");
+      if (tiny(opp, opp.getPrecision()))
+       {
+          //atan(x) is x - x ^ 3 / 3 and a bit.
+         zivTail = opp.isSigned() ? 1 : -1;
+         return opp;
+       }
 
       Float copyOpp (one);
       copyOpp |= opp;
       copyOpp.abs(); //Sign will be restored later.
       int Series = copyOpp.compare(one);
 
-      Float res (copyOpp);
-      Float currentPower (copyOpp);
-      copyOpp *= copyOpp;
-      currentPower *= copyOpp;
-
-      Float two (one);
-      two = Float("2");
-
-      Float temp (one);
-      temp |= M_PI_2;
+      Float res (one);
+      unsigned long digits = one.getPrecision();
 
       if (Series == 0)
        {
          //Both of the following series can compute this,
          //but it takes FOREVER!
-         res |= M_PI_4;
+         res |= constant(CONST_PI_4, res.getPrecision());
        }
       else if (Series > 0)
        {
-         bool alt = false;
-         res = temp - (one / res);
-
-         temp = one / (currentPower * currentFactor);
-         while (change(temp, res))
-          {
-            if (alt) res -= temp;
-            else res += temp;
-            alt = !alt;
-
-            currentFactor += two;
-
-            currentPower *= copyOpp;
-
-            temp = one / (currentPower * currentFactor);
-          }
+         res |= constant(CONST_PI_2, res.getPrecision());
+         res -= atanSplit(one / copyOpp, digits);
        }
       else
        {
-         bool alt = true;
-         temp = currentPower / currentFactor;
-         while (change(temp, res))
-          {
-            if (alt) res -= temp;
-            else res += temp;
-            alt = !alt;
-
-            currentFactor += two;
-
-            currentPower *= copyOpp;
-
-            temp = currentPower / currentFactor;
-          }
+         if (copyOpp.exponent() < 0) digits -= copyOpp.exponent();
+         res = atanSplit(copyOpp, digits);
        }
 
       if (opp.isSigned()) res.negate(); //restore sign
 
-      res.setPrecision(opp.getPrecision());
       return res;
     }
 
+   Float atan (const Float & opp)
+    {
+      Float one (opp);
+
+      if (opp.isZero()) return one;
+      if (opp.isNaN()) return opp;
+      if (opp.isInfinity())
+       {
+         one |= constant(CONST_PI_2, one.getPrecision());
+         if (opp.isSigned()) one.negate();
+         return one;
+       }
+
+      return ziv(atanAt, opp);
+    }
+
 /*
 ==============================================================================
    Function: principle inverse sine
@@ -709,19 +1600,19 @@ namespace BigInt
       if (copyOpp == one)
        {
          Float res (opp);
-         res |= M_PI_2;
+         res |= constant(CONST_PI_2, res.getPrecision());
          return res;
        }
       if (copyOpp == -one)
        {
          Float res (opp);
-         res |= -M_PI_2;
+         res |= -constant(CONST_PI_2, res.getPrecision());
          return res;
        }
 
       Float res (one);
 
-      res = atan(copyOpp / sqrt(one - (copyOpp * copyOpp)));
+      res = atan(copyOpp / sqrt(one - sqr(copyOpp)));
 
       res.setPrecision(opp.getPrecision());
       return res;
@@ -760,13 +1651,13 @@ namespace BigInt
       if (copyOpp == -one)
        {
          Float res (opp);
-         res |= M_PI;
+         res |= constant(CONST_PI, res.getPrecision());
          return res;
        }
 
       Float res (one);
 
-      res = atan(sqrt(one - (copyOpp * copyOpp)) / copyOpp);
+      res = atan(sqrt(one - sqr(copyOpp)) / copyOpp);
 
       res.setPrecision(opp.getPrecision());
       return res;
@@ -813,7 +1704,7 @@ namespace BigInt
        {
          if (bottom.isInfinity())
           {
-            one |= M_PI_4;
+            one |= constant(CONST_PI_4, one.getPrecision());
             if (bottom.isSigned())
              {
                one *= Float("3");
@@ -823,7 +1714,7 @@ namespace BigInt
           }
          else
           {
-            two |= M_PI_2;
+            two |= constant(CONST_PI_2, two.getPrecision());
             if (top.isSigned()) two.negate();
             return two;
           }
@@ -831,7 +1722,8 @@ namespace BigInt
 
       if (top.isZero())
        {
-         if (bottom.isSigned()) two |= M_PI;
+         if (bottom.isSigned())
+            two |= constant(CONST_PI, two.getPrecision());
          else two = Float();
          if (top.isSigned()) two.negate();
          return two;
@@ -839,7 +1731,8 @@ namespace BigInt
 
       if (bottom.isInfinity())
        {
-         if (bottom.isSigned()) one |= M_PI;
+         if (bottom.isSigned())
+            one |= constant(CONST_PI, one.getPrecision());
          else one = Float();
          if (top.isSigned()) one.negate();
          return one;
@@ -847,7 +1740,7 @@ namespace BigInt
 
       if (bottom.isZero())
        {
-         one |= M_PI_2;
+         one |= constant(CONST_PI_2, one.getPrecision());
          if (top.isSigned()) one.negate();
          return one;
        } //All thirty-two precomputed entries.
@@ -860,7 +1753,8 @@ namespace BigInt
          //Now fix the result based on the signs of the opperands.
       if (bottom.isSigned())
        {
-         two |= top.isSigned() ? -M_PI : M_PI;
+         two |= constant(CONST_PI, two.getPrecision());
+         if (top.isSigned()) two.negate();
          one += two;
        }
 
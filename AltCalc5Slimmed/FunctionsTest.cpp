@@ -0,0 +1,355 @@
+/*
+Copyright (c) 2013 Thomas DiModica.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+3. Neither the name of Thomas DiModica nor the names of other contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THOMAS DIMODICA AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED.  IN NO EVENT SHALL THOMAS DIMODICA OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+SUCH DAMAGE.
+*/
+
+/*
+   Checks values that Functions.cpp must get exactly, on both sides of the
+   precisions where it changes methods. FunctionsTest.sh builds and runs
+   it; it prints each failure and exits nonzero if there are any.
+*/
+#include <cstdio>
+#include <string>
+
+#include "Float.hpp"
+#include "Constants.hpp"
+
+namespace BigInt
+ {
+   extern unsigned long AGMPRECISION;
+   extern unsigned long TRIGSPLITPRECISION;
+ }
+
+using namespace BigInt;
+
+static int failures = 0;
+
+static void check (bool ok, const std::string & what, unsigned long precision)
+ {
+   if (!ok)
+    {
+      std::printf("FAILED: %s at %lu digits\n", what.c_str(), precision);
+      failures++;
+    }
+ }
+
+   /* The precisions just below, at and above a crossover, and well past it. */
+static void around (unsigned long crossover, unsigned long precisions [5])
+ {
+   precisions[0] = (crossover > 20) ? crossover - 20 : 1;
+   precisions[1] = (crossover > 1) ? crossover - 1 : 1;
+   precisions[2] = crossover;
+   precisions[3] = crossover + 1;
+   precisions[4] = 2 * crossover + 11;
+ }
+
+static void lnOne (void)
+ {
+   unsigned long precisions [5];
+   around(AGMPRECISION, precisions);
+
+   for (int i = 0; i < 5; i++)
+    {
+      Float one (Integer(1), 0, precisions[i]);
+      Float res (log(one));
+      check(res.isZero() && !res.isSigned(), "ln(1) == 0", precisions[i]);
+    }
+ }
+
+   /*
+      In every rounding mode, a constant must be its value to forty more
+      digits, rounded once in that mode. Rounding it twice, once to nearest
+      and then in the mode, is off by one now and then. The precisions run
+      past the end of the tables in Constants.cpp, and over the six nines
+      that start at the 762nd decimal of pi.
+   */
+static void constants (void)
+ {
+   static const Fixed_Round_Mode modes [] =
+    {
+      ROUND_TIES_EVEN, ROUND_TIES_AWAY, ROUND_POSITIVE_INFINITY,
+      ROUND_NEGATIVE_INFINITY, ROUND_ZERO, ROUND_TIES_ODD, ROUND_TIES_ZERO,
+      ROUND_AWAY, ROUND_05_AWAY
+    };
+   static const char * names [] =
+    {
+      "ln(2)", "ln(10)", "pi", "pi / 2", "pi / 4", "2 pi", "1 / (2 pi)",
+      "1 / sqrt(10)"
+    };
+   Fixed_Round_Mode mode = Fixed::getRoundMode();
+
+   for (unsigned long precision = 1; precision < 770;
+        precision += (precision < 750) ? 7 : 1)
+      for (int which = 0; which < CONSTANTS; which++)
+       {
+         Float exact (constant((Constant)which, precision + 40));
+
+         for (int m = 0; m < 9; m++)
+          {
+            Fixed::setRoundMode(modes[m]);
+            Float once (exact);
+            once.setPrecision(precision);
+            Float res (constant((Constant)which, precision));
+            check(res.compare(once) == 0, std::string(names[which]) +
+               " rounded once, in mode " + std::to_string(m), precision);
+          }
+         Fixed::setRoundMode(mode);
+       }
+ }
+
+   /*
+      Below TRIGSPLITPRECISION, sin and cos are summed term by term with the
+      cached coefficients, and above it they are split: both must agree
+      with a longer value rounded once. exp and atan always split.
+   */
+static void series (void)
+ {
+   static Float (* const functions [])(const Float &) =
+      { sin, cos, exp, atan };
+   static const char * names [] = { "sin", "cos", "exp", "atan" };
+   static const char * arguments [] = { "0.5", "-3.25", "17.125" };
+   unsigned long precisions [5];
+   around(TRIGSPLITPRECISION, precisions);
+
+   for (int i = 0; i < 5; i++)
+      for (int f = 0; f < 4; f++)
+         for (int a = 0; a < 3; a++)
+          {
+            Float x (Float(arguments[a]));
+            x.setPrecision(precisions[i] + 30);
+            Float once (functions[f](x));
+            once.setPrecision(precisions[i]);
+
+            x.setPrecision(precisions[i]);
+            Float res (functions[f](x));
+            check(res.compare(once) == 0, std::string(names[f]) + "(" +
+               arguments[a] + ") rounded once", precisions[i]);
+          }
+ }
+
+   /*
+      x ^ -n is 1 over the exact x ^ n, rounded once. The reference divides
+      at many more digits; ROUND_05_AWAY also rounds exact quotients, so it
+      is left out.
+   */
+static void powers (void)
+ {
+   static const char * bases [] = { "3.1955", "2.5", "-1.0001", "7", "0.96" };
+   unsigned long precisions [] = { 3, 8, 20 };
+   Fixed_Round_Mode mode = Fixed::getRoundMode();
+
+   for (int b = 0; b < 5; b++)
+      for (unsigned long n = 1; n <= 6; n++)
+         for (int i = 0; i < 3; i++)
+            for (int m = 0; m < 8; m++)
+             {
+               Fixed::setRoundMode((Fixed_Round_Mode)m);
+               unsigned long precision = precisions[i];
+               Float x (bases[b]), power (Integer(1), 0, 200);
+               x.setPrecision(precision);
+               for (unsigned long k = 0; k < n; k++) power *= x;
+
+               Float once (Float(Integer(1), 0, 200) / power);
+               once.setPrecision(precision);
+               Float res (pow(x, Float(Integer(-(long)n), 0, precision)));
+               check(res.compare(once) == 0, std::string(bases[b]) + " ^ -" +
+                  std::to_string(n) + " in mode " + std::to_string(m),
+                  precision);
+             }
+   Fixed::setRoundMode(mode);
+
+   Float x (Integer(31955), -4, 8);
+   check(pow(x, Float(Integer(-2), 0, 8)).compare(Float("9.79314886E-2")) == 0,
+      "3.1955 ^ -2", 8);
+
+      //0.142857 and 0.143 are not 1 / 7, but 0.125 is 1 / 8.
+   Float y (Integer(46), -2, 5), z (y), seventh (Integer(142857), -6, 5);
+   z.setPrecision(30);
+   Float once (pow(z, Float(Integer(142857), -6, 30)));
+   once.setPrecision(5);
+   check(pow(y, seventh).compare(once) == 0, "0.46 ^ 0.142857", 5);
+
+   Float tiny (Integer(1), -30, 2), longer (Integer(1), -30, 30);
+   once = pow(longer, Float(Integer(143), -3, 30));
+   once.setPrecision(2);
+   check(pow(tiny, Float(Integer(143), -3, 2)).compare(once) == 0,
+      "1E-30 ^ 0.143", 2);
+
+   once = root(z, 8);
+   once.setPrecision(5);
+   check(pow(y, Float(Integer(125), -3, 5)).compare(once) == 0,
+      "0.46 ^ 0.125", 5);
+ }
+
+   /*
+      Arguments near multiples of pi / 2 cancel in the reduction for sin
+      and cos, and huge ones need many digits of 1 / (2 pi). They must
+      still agree with a longer value rounded once, in every round mode
+      but ROUND_05_AWAY.
+   */
+static void reduction (void)
+ {
+   static Float (* const functions [])(const Float &) = { sin, cos };
+   static const char * names [] = { "sin", "cos" };
+   static const char * arguments [] =
+    {
+      "6.283185307179586476925286766559", "1.57079632679489661923",
+      "-3.14159265358979323846264338327950288", "4.71238898038469", "355",
+      "0.785398163397448309615660845819875721", "1E22", "-1E100"
+    };
+   unsigned long precisions [] = { 5, 16, 20, 30, 60 };
+   Fixed_Round_Mode mode = Fixed::getRoundMode();
+
+   for (int a = 0; a < 8; a++)
+      for (int i = 0; i < 5; i++)
+       {
+         Float x (arguments[a]);
+         x.setPrecision(precisions[i]);
+         Float longer (x);
+         longer.setPrecision(precisions[i] + 80);
+
+         for (int f = 0; f < 2; f++)
+            for (int m = 0; m < 8; m++)
+             {
+               Fixed::setRoundMode((Fixed_Round_Mode)m);
+               Float once (functions[f](longer));
+               once.setPrecision(precisions[i]);
+               Float res (functions[f](x));
+               check(res.compare(once) == 0, std::string(names[f]) + "(" +
+                  arguments[a] + ") in mode " + std::to_string(m),
+                  precisions[i]);
+             }
+         Fixed::setRoundMode(mode);
+       }
+
+   Float x ("6.283185307179586476925286766559");
+   x.setPrecision(30);
+   check(sin(x).compare(
+      Float("-5.768394338798750211641949889185E-33")) == 0,
+      "sin(6.283185307179586476925286766559)", 30);
+
+   x = Float("1.57079632679489661923");
+   x.setPrecision(20);
+   check(cos(x).compare(Float("1.32169163975144209858E-21")) == 0,
+      "cos(1.57079632679489661923)", 20);
+ }
+
+   /*
+      Near 0, sin, cos, exp and atan come within any number of digits of 1
+      or of their argument, but are never equal to it, so the directed
+      round modes must still go the right way.
+   */
+static void tails (void)
+ {
+   static Float (* const functions [])(const Float &) =
+      { sin, cos, exp, atan };
+   static const char * names [] = { "sin", "cos", "exp", "atan" };
+   static const char * arguments [] =
+      { "1E-30", "-1E-30", "-2.5E-17", "3E-8" };
+   unsigned long precisions [] = { 5, 10, 20 };
+   Fixed_Round_Mode mode = Fixed::getRoundMode();
+
+   for (int a = 0; a < 4; a++)
+      for (int i = 0; i < 3; i++)
+       {
+         Float x (arguments[a]);
+         x.setPrecision(precisions[i]);
+         Float longer (x);
+         longer.setPrecision(precisions[i] + 80);
+
+         for (int f = 0; f < 4; f++)
+            for (int m = 0; m < 8; m++)
+             {
+               Fixed::setRoundMode((Fixed_Round_Mode)m);
+               Float once (functions[f](longer));
+               once.setPrecision(precisions[i]);
+               Float res (functions[f](x));
+               check(res.compare(once) == 0, std::string(names[f]) + "(" +
+                  arguments[a] + ") in mode " + std::to_string(m),
+                  precisions[i]);
+             }
+         Fixed::setRoundMode(mode);
+       }
+ }
+
+   /*
+      The square root of a perfect square is exact in every round mode, and
+      any other is its value to many more digits, rounded once.
+   */
+static void roots (void)
+ {
+   static const char * arguments [] =
+    {
+      "2.25", "9", "1E-20", "0.0144", "2", "0.5", "99.999999",
+      "152415787532388367501905199875019052100"
+    };
+   unsigned long precisions [] = { 3, 10, 30 };
+   Fixed_Round_Mode mode = Fixed::getRoundMode();
+
+   for (int a = 0; a < 8; a++)
+      for (int i = 0; i < 3; i++)
+       {
+         Float x (arguments[a]);
+         x.setPrecision(precisions[i]);
+         Float longer (x);
+         longer.setPrecision(precisions[i] + 80);
+
+         for (int m = 0; m < 8; m++)
+          {
+            Fixed::setRoundMode((Fixed_Round_Mode)m);
+            Float once (sqrt(longer));
+            once.setPrecision(precisions[i]);
+            Float res (sqrt(x));
+            check(res.compare(once) == 0, std::string("sqrt(") +
+               arguments[a] + ") in mode " + std::to_string(m), precisions[i]);
+          }
+         Fixed::setRoundMode(mode);
+       }
+
+   Fixed::setRoundMode(ROUND_ZERO);
+   Float x ("2.25");
+   x.setPrecision(10);
+   check(sqrt(x).compare(Float("1.5")) == 0, "sqrt(2.25) is 1.5", 10);
+   x = Float("9");
+   x.setPrecision(30);
+   check(sqrt(x).compare(Float("3")) == 0, "sqrt(9) is 3", 30);
+   Fixed::setRoundMode(mode);
+ }
+
+int main (void)
+ {
+   lnOne();
+   constants();
+   series();
+   powers();
+   reduction();
+   tails();
+   roots();
+
+   if (failures == 0) std::printf("All passed\n");
+   return (failures == 0) ? 0 : 1;
+ }
@@ -0,0 +1 @@
+g++ -O2 -Wall -Wextra -Wpedantic -Wconversion -o FunctionsTest FunctionsTest.cpp Float.cpp Fixed.cpp Constants.cpp Functions.cpp Integer.cpp BitField.cpp && ./FunctionsTest
@@ -50,7 +50,7 @@ namespace BigInt
          BitField Digits;
          bool Sign;
 
-         static Integer adder (const Integer &, const Integer &);
+         void adder (const Integer &, bool);
 
       public:
          Integer ();
@@ -59,6 +59,7 @@ namespace BigInt
          Integer (long);
          Integer (int);
          Integer (const Integer &);
+         Integer (Integer &&);
          Integer (const std::string &, int base = 10);
          Integer (const char *, int base = 10);
          ~Integer ();
@@ -77,16 +78,15 @@ namespace BigInt
          Integer & abs (void);
          Integer & setSign (bool);
 
-         friend Integer operator + (const Integer &, const Integer &);
-         friend Integer operator - (const Integer &, const Integer &);
-         friend Integer operator * (const Integer &, const Integer &);
-
          Integer & operator = (const Integer &);
+         Integer & operator = (Integer &&);
 
          Integer & operator += (const Integer &);
          Integer & operator -= (const Integer &);
          Integer & operator *= (const Integer &);
 
+         Integer & square (void);
+
          Integer operator - (void) const;
 
          long toInt (void) const; //Not perfect, but not terrible.
@@ -110,9 +110,23 @@ namespace BigInt
 
     }; /* class Integer */
 
+    /*
+      The rvalue overloads reuse the storage of an operand that is about
+      to die, rather than allocate the result.
+    */
    Integer operator + (const Integer &, const Integer &);
+   Integer operator + (Integer &&, const Integer &);
+   Integer operator + (const Integer &, Integer &&);
+   Integer operator + (Integer &&, Integer &&);
    Integer operator - (const Integer &, const Integer &);
+   Integer operator - (Integer &&, const Integer &);
+   Integer operator - (const Integer &, Integer &&);
+   Integer operator - (Integer &&, Integer &&);
    Integer operator * (const Integer &, const Integer &);
+   Integer operator * (Integer &&, const Integer &);
+   Integer operator * (const Integer &, Integer &&);
+   Integer operator * (Integer &&, Integer &&);
+   Integer sqr (const Integer &);
    Integer pow (const Integer &, const Integer &);
 
  } /* namespace BigInt */
@@ -809,6 +809,1020 @@ namespace BigInt
 
 
 
+    /*
+      Multiplication of whole BitFields.
+
+      Integer used to do long multiplication a row at a time with the
+      operators above: copy, multiply by a Unit, shift, and add. That is four
+      passes over the data for every Unit of the smaller number. These work
+      directly on the Unit arrays instead, and pick an algorithm by size:
+
+         schoolbook     O(n^2)      below KaratsubaCutoff Units
+         Karatsuba      O(n^1.585)  below ToomCookCutoff Units
+         Toom-Cook 3    O(n^1.465)  below NttCutoff Units
+         NTT            O(n log n)  above that, with 64-bit Units
+
+      The cutoffs were found by timing on x86-64 with 64-bit Units. Operands
+      of very different lengths are cut into pieces the size of the smaller
+      one, so that the recursive algorithms always see balanced operands.
+      The recursions only make progress with cutoffs of at least four and
+      six Units, respectively.
+
+      None of these routines normalize: the result array is always exactly
+      an + bn Units long, and the top Unit may be zero.
+    */
+   const static long KaratsubaCutoff = 32;
+   const static long ToomCookCutoff = 160;
+
+    /* r = a * m, returns the carry out. */
+   static Unit mulUnit (Unit * r, const Unit * a, long n, Unit m)
+    {
+      unsigned NEXT_TYPE temp;
+      Unit carry = 0;
+
+      for (long i = 0; i < n; i++)
+       {
+         temp = (unsigned NEXT_TYPE)a[i] * m + carry;
+         r[i] = (Unit)temp;
+         carry = (Unit)(temp >> BitField::bits);
+       }
+
+      return carry;
+    }
+
+    /* r += a * m, returns the carry out. */
+   static Unit addMulUnit (Unit * r, const Unit * a, long n, Unit m)
+    {
+      unsigned NEXT_TYPE temp;
+      Unit carry = 0;
+
+      for (long i = 0; i < n; i++)
+       {
+         temp = (unsigned NEXT_TYPE)a[i] * m + r[i] + carry;
+         r[i] = (Unit)temp;
+         carry = (Unit)(temp >> BitField::bits);
+       }
+
+      return carry;
+    }
+
+    /* r = a + b, where an >= bn. r has an Units. Returns the carry out. */
+   static Unit addUnits (Unit * r, const Unit * a, long an,
+                         const Unit * b, long bn)
+    {
+      Unit carry = 0, temp;
+      long i;
+
+      for (i = 0; i < bn; i++)
+       {
+         temp = a[i] + carry;
+         carry = (temp < carry) ? 1 : 0;
+         r[i] = temp + b[i];
+         carry += (r[i] < temp) ? 1 : 0;
+       }
+      for (; i < an; i++)
+       {
+         r[i] = a[i] + carry;
+         carry = (r[i] < carry) ? 1 : 0;
+       }
+
+      return carry;
+    }
+
+    /*
+      r += a, where rn >= an, with the carry propagated through r.
+      Returns the carry out of r.
+    */
+   static Unit addInto (Unit * r, long rn, const Unit * a, long an)
+    {
+      Unit carry = 0, temp;
+      long i;
+
+      for (i = 0; i < an; i++)
+       {
+         temp = a[i] + carry;
+         carry = (temp < carry) ? 1 : 0;
+         r[i] += temp;
+         carry += (r[i] < temp) ? 1 : 0;
+       }
+      for (; (i < rn) && (carry != 0); i++)
+       {
+         r[i] += carry;
+         carry = (r[i] < carry) ? 1 : 0;
+       }
+
+      return carry;
+    }
+
+    /*
+      r -= a, where rn >= an, with the borrow propagated through r.
+      Returns the borrow out of r.
+    */
+   static Unit subFrom (Unit * r, long rn, const Unit * a, long an)
+    {
+      Unit borrow = 0, temp;
+      long i;
+
+      for (i = 0; i < an; i++)
+       {
+         temp = a[i] + borrow;
+         borrow = (temp < borrow) ? 1 : 0;
+         borrow += (r[i] < temp) ? 1 : 0;
+         r[i] -= temp;
+       }
+      for (; (i < rn) && (borrow != 0); i++)
+       {
+         borrow = (r[i] == 0) ? 1 : 0;
+         r[i]--;
+       }
+
+      return borrow;
+    }
+
+   static void mulUnits (Unit *, const Unit *, long, const Unit *, long);
+
+    /* r = a * b, the O(n^2) way. */
+   static void mulSchool (Unit * r, const Unit * a, long an,
+                          const Unit * b, long bn)
+    {
+      r[an] = mulUnit(r, a, an, b[0]);
+      for (long j = 1; j < bn; j++)
+         r[an + j] = addMulUnit(r + j, a, an, b[j]);
+    }
+
+    /*
+      r = a * b, where bn > (an + 1) / 2.
+      With x = 2^(bits * k): a = a1 * x + a0 and b = b1 * x + b0, so
+         a * b = a1b1 * x^2 + ((a0 + a1)(b0 + b1) - a0b0 - a1b1) * x + a0b0
+      Three multiplications of half the size instead of four.
+    */
+   static void mulKaratsuba (Unit * r, const Unit * a, long an,
+                             const Unit * b, long bn)
+    {
+      long k = (an + 1) / 2, rn = an + bn;
+      Unit * sa = new Unit [4 * k + 4], * sb = sa + k + 1, * t = sb + k + 1;
+
+      mulUnits(r, a, k, b, k);
+      mulUnits(r + 2 * k, a + k, an - k, b + k, bn - k);
+
+      sa[k] = addUnits(sa, a, k, a + k, an - k);
+      sb[k] = addUnits(sb, b, k, b + k, bn - k);
+      mulUnits(t, sa, k + 1, sb, k + 1);
+
+      subFrom(t, 2 * k + 2, r, 2 * k);
+      subFrom(t, 2 * k + 2, r + 2 * k, rn - 2 * k);
+
+       /* Anything in t that would go past the end of r is zero. */
+      addInto(r + k, rn - k, t, (2 * k + 2 < rn - k) ? 2 * k + 2 : rn - k);
+
+      delete [] sa;
+    }
+
+    /*
+      Toom-Cook 3 works on fixed-width two's complement numbers, because
+      the evaluation at -1 and -2 and the interpolation have negative
+      intermediate results. These are the helpers for that.
+    */
+   static void tcLoad (Unit * r, long n, const Unit * a, long an)
+    {
+      if (an > n) an = n;
+      if (an > 0) std::memcpy(r, a, an * sizeof(Unit));
+      if (n > an) std::memset(r + an, '\0', (n - an) * sizeof(Unit));
+    }
+
+   static bool tcIsNegative (const Unit * a, long n)
+    {
+      return (a[n - 1] >> (BitField::bits - 1)) != 0;
+    }
+
+   static void tcNegate (Unit * r, long n)
+    {
+      Unit carry = 1;
+      for (long i = 0; i < n; i++)
+       {
+         r[i] = ~r[i] + carry;
+         carry = ((r[i] == 0) && (carry != 0)) ? 1 : 0;
+       }
+    }
+
+    /* Arithmetic shift right by one bit. */
+   static void tcHalve (Unit * r, long n)
+    {
+      Unit top = r[n - 1] & (((Unit)1) << (BitField::bits - 1));
+      for (long i = 0; i < n - 1; i++)
+         r[i] = (r[i] >> 1) | (r[i + 1] << (BitField::bits - 1));
+      r[n - 1] = (r[n - 1] >> 1) | top;
+    }
+
+    /*
+      Exact division by three: multiply by the inverse of three modulo the
+      radix, limb by limb, from the bottom up. This gives the quotient
+      modulo 2^(bits * n), which is the quotient if the division is exact.
+    */
+   static void tcThird (Unit * r, long n)
+    {
+      const Unit inverse = (Unit)(((unsigned NEXT_TYPE)mask / 3) * 2 + 1);
+      Unit carry = 0, borrow, temp;
+
+      for (long i = 0; i < n; i++)
+       {
+         temp = r[i];
+         borrow = (temp < carry) ? 1 : 0;
+         temp -= carry;
+         r[i] = temp * inverse;
+         carry = (Unit)(((unsigned NEXT_TYPE)r[i] * 3) >> BitField::bits) +
+            borrow;
+       }
+    }
+
+    /*
+      r = a * b, with a and b cut in thirds.
+      Evaluate at 0, 1, -1, -2, and infinity, multiply the five pairs, and
+      interpolate the five coefficients of the product. The interpolation
+      sequence is Bodrato's.
+    */
+   static void mulToomCook (Unit * r, const Unit * a, long an,
+                            const Unit * b, long bn)
+    {
+      long k = (an + 2) / 3, rn = an + bn, i;
+      long L = k + 2, W = 2 * L;
+      long b0n, b1n, b2n;
+
+      b0n = (bn < k) ? bn : k;
+      b1n = (bn - k < 0) ? 0 : ((bn - k > k) ? k : bn - k);
+      b2n = (bn - 2 * k < 0) ? 0 : bn - 2 * k;
+
+      Unit * scratch = new Unit [6 * L + 4 * W];
+      Unit * ea = scratch, * eb = ea + L, * ta = eb + L, * tb = ta + L;
+      Unit * ma = tb + L, * mb = ma + L;
+      Unit * r1 = mb + L, * rm1 = r1 + W, * rm2 = rm1 + W, * t = rm2 + W;
+      bool signA, signB;
+
+       /* r(0) and r(inf) go straight into the result. */
+      mulUnits(r, a, k, b, b0n);
+      if (b0n < k) std::memset(r + k + b0n, '\0', (k - b0n) * sizeof(Unit));
+      std::memset(r + 2 * k, '\0', (rn - 2 * k) * sizeof(Unit));
+      if (b2n != 0) mulUnits(r + 4 * k, a + 2 * k, an - 2 * k, b + 2 * k, b2n);
+
+       /* ta = a0 + a2, and tb = b0 + b2 */
+      tcLoad(ta, L, a, k);
+      addInto(ta, L, a + 2 * k, an - 2 * k);
+      tcLoad(tb, L, b, b0n);
+      addInto(tb, L, b + 2 * k, b2n);
+
+       /* r(1) */
+      tcLoad(ea, L, ta, L);
+      addInto(ea, L, a + k, k);
+      tcLoad(eb, L, tb, L);
+      addInto(eb, L, b + k, b1n);
+      mulUnits(r1, ea, L, eb, L);
+
+       /* r(-1) */
+      tcLoad(ma, L, ta, L);
+      subFrom(ma, L, a + k, k);
+      tcLoad(mb, L, tb, L);
+      subFrom(mb, L, b + k, b1n);
+
+      tcLoad(ea, L, ma, L);
+      tcLoad(eb, L, mb, L);
+      signA = tcIsNegative(ea, L);
+      signB = tcIsNegative(eb, L);
+      if (signA) tcNegate(ea, L);
+      if (signB) tcNegate(eb, L);
+      mulUnits(rm1, ea, L, eb, L);
+      if (signA != signB) tcNegate(rm1, W);
+
+       /* r(-2): ((a0 - a1 + a2) + a2) * 2 - a0 */
+      addInto(ma, L, a + 2 * k, an - 2 * k);
+      addInto(ma, L, ma, L);
+      subFrom(ma, L, a, k);
+      addInto(mb, L, b + 2 * k, b2n);
+      addInto(mb, L, mb, L);
+      subFrom(mb, L, b, b0n);
+
+      signA = tcIsNegative(ma, L);
+      signB = tcIsNegative(mb, L);
+      if (signA) tcNegate(ma, L);
+      if (signB) tcNegate(mb, L);
+      mulUnits(rm2, ma, L, mb, L);
+      if (signA != signB) tcNegate(rm2, W);
+
+       /*
+         Interpolate, in place:
+            r3 = (r(-2) - r(1)) / 3          -> rm2
+            r1 = (r(1) - r(-1)) / 2          -> r1
+            r2 = r(-1) - r(0)                -> rm1
+            r3 = (r2 - r3) / 2 + 2 * r(inf)  -> rm2
+            r2 = r2 + r1 - r(inf)            -> rm1
+            r1 = r1 - r3                     -> r1
+       */
+      subFrom(rm2, W, r1, W);
+      tcThird(rm2, W);
+
+      subFrom(r1, W, rm1, W);
+      tcHalve(r1, W);
+
+      tcLoad(t, W, r, 2 * k);
+      subFrom(rm1, W, t, W);
+
+      tcLoad(t, W, rm1, W);
+      subFrom(t, W, rm2, W);
+      tcHalve(t, W);
+      tcLoad(rm2, W, t, W);
+      tcLoad(t, W, r + 4 * k, rn - 4 * k);
+      addInto(rm2, W, t, W);
+      addInto(rm2, W, t, W);
+
+      addInto(rm1, W, r1, W);
+      subFrom(rm1, W, t, W);
+
+      subFrom(r1, W, rm2, W);
+
+       /*
+         The three middle coefficients are all non-negative now. Add them
+         in. Whatever would land past the end of r is zero.
+       */
+      for (i = 1; i <= 3; i++)
+       {
+         Unit * c = (i == 1) ? r1 : ((i == 2) ? rm1 : rm2);
+         long cn = (W < rn - i * k) ? W : rn - i * k;
+         addInto(r + i * k, rn - i * k, c, cn);
+       }
+
+      delete [] scratch;
+    }
+
+#ifndef BIG_INT_QUAD_BYTE
+
+    /*
+      Above NttCutoff Units, even Toom-Cook is too slow, and we multiply
+      with number-theoretic transforms instead. The product of two Units is
+      less than 2^128, so a coefficient of the convolution of n Units is
+      less than n * 2^128. We do the convolution modulo three primes that
+      are just under 2^61, and put each coefficient back together with the
+      Chinese Remainder Theorem: their product is about 2^183, which is good
+      for up to 2^55 Units.
+
+      Each prime is c * 2^40 + 1, so transforms can be up to 2^40 long. The
+      arithmetic is Montgomery multiplication with R = 2^64. The forward
+      transform is decimation in frequency, which leaves its output in
+      bit-reversed order; the inverse transform is decimation in time, which
+      takes its input in bit-reversed order. So we never have to permute.
+
+      This needs 64-bit Units and a 128-bit NEXT_TYPE. With 32-bit Units,
+      we stop at Toom-Cook.
+    */
+   const static long NttCutoff = 7168;
+
+   struct NttPrime
+    {
+      Unit p;          // the prime
+      Unit g;          // a primitive root modulo p
+      Unit negInverse; // -1 / p modulo 2^64
+      Unit r2;         // 2^128 modulo p
+    };
+
+   const static NttPrime NttPrimes [3] =
+    {
+      { 2305835312632299521ULL,  3ULL, 2305835312632299519ULL,   41253674629982928ULL },
+      { 2305804526306721793ULL,  5ULL, 2305804526306721791ULL, 1030498540330518661ULL },
+      { 2305778138027655169ULL, 13ULL, 2305778138027655167ULL, 1030976752187202484ULL }
+    };
+
+    /*
+      Constants for Garner's algorithm. The inverses are in Montgomery form,
+      so that nttMul by them is multiplication by the inverse.
+    */
+   const static Unit NttP1InvP2 = 1317602586461583068ULL;
+   const static Unit NttP1InvP3 = 354735098158423434ULL;
+   const static Unit NttP2InvP3 = 768592712676584107ULL;
+   const static Unit NttP1P2Low = 4611639838939021313ULL;
+   const static Unit NttP1P2High = 288224603731722240ULL;
+
+    /*
+      Montgomery reduction of a * b. a * b must be less than p * 2^64,
+      which is true whenever one of them is reduced.
+    */
+   static inline Unit nttMul (Unit a, Unit b, const NttPrime & P)
+    {
+      unsigned NEXT_TYPE t = (unsigned NEXT_TYPE)a * b;
+      Unit m = (Unit)t * P.negInverse;
+      Unit u = (Unit)((t + (unsigned NEXT_TYPE)m * P.p) >> BitField::bits);
+      return (u >= P.p) ? u - P.p : u;
+    }
+
+   static Unit nttPow (Unit base, Unit exp, const NttPrime & P)
+    {
+      Unit result = nttMul(1, P.r2, P); // one, in Montgomery form
+      while (exp != 0)
+       {
+         if (exp & 1) result = nttMul(result, base, P);
+         base = nttMul(base, base, P);
+         exp >>= 1;
+       }
+      return result;
+    }
+
+    /*
+      The roots of unity for a butterfly of half-length h are in
+      roots[h .. 2h - 1], so that each pass reads its roots in order:
+      roots[h + j] is v^j, where v is a primitive 2h-th root of unity.
+      The inverse transform is given the table for the inverse root.
+    */
+   static void nttRoots (Unit * roots, long n, Unit w, const NttPrime & P)
+    {
+      Unit x = nttMul(1, P.r2, P);
+      long i, h;
+
+      for (i = 0; i < n / 2; i++)
+       {
+         roots[n / 2 + i] = x;
+         x = nttMul(x, w, P);
+       }
+      for (h = n / 4; h >= 1; h >>= 1)
+         for (i = 0; i < h; i++)
+            roots[h + i] = roots[2 * h + 2 * i];
+    }
+
+   static void nttForward (Unit * a, long n, const Unit * roots,
+                           const NttPrime & P)
+    {
+      Unit u, v;
+      for (long half = n >> 1; half >= 1; half >>= 1)
+       {
+         for (long s = 0; s < n; s += 2 * half)
+          {
+            for (long j = 0; j < half; j++)
+             {
+               u = a[s + j];
+               v = a[s + j + half];
+               a[s + j] = (u + v >= P.p) ? u + v - P.p : u + v;
+               a[s + j + half] = nttMul((u >= v) ? u - v : u + P.p - v,
+                                        roots[half + j], P);
+             }
+          }
+       }
+    }
+
+   static void nttInverse (Unit * a, long n, const Unit * roots,
+                           const NttPrime & P)
+    {
+      Unit u, v;
+      for (long half = 1; half < n; half <<= 1)
+       {
+         for (long s = 0; s < n; s += 2 * half)
+          {
+            for (long j = 0; j < half; j++)
+             {
+               u = a[s + j];
+               v = nttMul(a[s + j + half], roots[half + j], P);
+               a[s + j] = (u + v >= P.p) ? u + v - P.p : u + v;
+               a[s + j + half] = (u >= v) ? u - v : u + P.p - v;
+             }
+          }
+       }
+    }
+
+    /*
+      c = a * b modulo P, as a cyclic convolution of length n.
+      c is left in Montgomery form, scaled by n.
+    */
+   static void nttConvolve (Unit * c, const Unit * a, long an,
+                            const Unit * b, long bn, long n, Unit * scratch,
+                            const NttPrime & P)
+    {
+      Unit * fb = scratch, * roots = scratch + n, w;
+      long i;
+
+       /* The Montgomery multiply by 2^128 both reduces and converts. */
+      for (i = 0; i < an; i++) c[i] = nttMul(a[i], P.r2, P);
+      for (; i < n; i++) c[i] = 0;
+      for (i = 0; i < bn; i++) fb[i] = nttMul(b[i], P.r2, P);
+      for (; i < n; i++) fb[i] = 0;
+
+      w = nttPow(nttMul(P.g, P.r2, P), (P.p - 1) / (Unit)n, P);
+      nttRoots(roots, n, w, P);
+
+      nttForward(c, n, roots, P);
+      nttForward(fb, n, roots, P);
+      for (i = 0; i < n; i++) c[i] = nttMul(c[i], fb[i], P);
+
+       /* The inverse root is w^(n - 1). */
+      nttRoots(roots, n, nttPow(w, (Unit)n - 1, P), P);
+      nttInverse(c, n, roots, P);
+    }
+
+    /* The length of the transform for a product of rn Units. */
+   static long nttLength (long rn)
+    {
+      long n = 1;
+      while (n < rn - 1) n <<= 1;
+      return n;
+    }
+
+    /*
+      The transform length is a power of two, so a product just over a power
+      of two wastes half of it. Toom-Cook is faster then, until the numbers
+      get big enough for the asymptotics to pay for the padding.
+    */
+   static bool useNtt (long an, long bn)
+    {
+      if (bn < NttCutoff) return false;
+      if (bn >= 4 * NttCutoff) return true;
+      return 2 * nttLength(an + bn) <= 3 * (an + bn);
+    }
+
+    /*
+      r = a * b, by three transforms and the Chinese Remainder Theorem.
+    */
+   static void mulNtt (Unit * r, const Unit * a, long an,
+                       const Unit * b, long bn)
+    {
+      long rn = an + bn, n = nttLength(rn), i, j;
+      Unit * c [3], * scratch, nInverse [3];
+      unsigned NEXT_TYPE carry = 0, t, low;
+      Unit v1, v2, v3, x0, x1, x2;
+
+      c[0] = new Unit [5 * n];
+      c[1] = c[0] + n;
+      c[2] = c[1] + n;
+      scratch = c[2] + n;
+
+      for (j = 0; j < 3; j++)
+       {
+         nttConvolve(c[j], a, an, b, bn, n, scratch, NttPrimes[j]);
+          /*
+            nttMul(x, 1 / n) takes x out of Montgomery form and removes the
+            factor of n in one go. 1 / n is p - (p - 1) / n.
+          */
+         nInverse[j] = NttPrimes[j].p - (NttPrimes[j].p - 1) / (Unit)n;
+       }
+
+      for (i = 0; i < rn; i++)
+       {
+         if (i < rn - 1)
+          {
+            v1 = nttMul(c[0][i], nInverse[0], NttPrimes[0]);
+            v2 = nttMul(c[1][i], nInverse[1], NttPrimes[1]);
+            v3 = nttMul(c[2][i], nInverse[2], NttPrimes[2]);
+
+             /*
+              v2 = (r2 - v1) / p1 modulo p2
+              v3 = ((r3 - v1) / p1 - v2) / p2 modulo p3
+              The primes are close enough that a residue of one of them
+              is reduced modulo another by one subtraction.
+            */
+            x0 = (v1 >= NttPrimes[1].p) ? v1 - NttPrimes[1].p : v1;
+            v2 = (v2 >= x0) ? v2 - x0 : v2 + NttPrimes[1].p - x0;
+            v2 = nttMul(v2, NttP1InvP2, NttPrimes[1]);
+
+            x0 = (v1 >= NttPrimes[2].p) ? v1 - NttPrimes[2].p : v1;
+            v3 = (v3 >= x0) ? v3 - x0 : v3 + NttPrimes[2].p - x0;
+            v3 = nttMul(v3, NttP1InvP3, NttPrimes[2]);
+            x0 = (v2 >= NttPrimes[2].p) ? v2 - NttPrimes[2].p : v2;
+            v3 = (v3 >= x0) ? v3 - x0 : v3 + NttPrimes[2].p - x0;
+            v3 = nttMul(v3, NttP2InvP3, NttPrimes[2]);
+
+             /* x = v1 + v2 * p1 + v3 * p1 * p2, in three Units */
+            t = (unsigned NEXT_TYPE)v2 * NttPrimes[0].p + v1;
+            low = (unsigned NEXT_TYPE)v3 * NttP1P2Low + (Unit)t;
+            x0 = (Unit)low;
+            t = (t >> BitField::bits) + (low >> BitField::bits) +
+               (unsigned NEXT_TYPE)v3 * NttP1P2High;
+            x1 = (Unit)t;
+            x2 = (Unit)(t >> BitField::bits);
+          }
+         else
+          {
+            x0 = x1 = x2 = 0;
+          }
+
+         t = (unsigned NEXT_TYPE)x0 + (Unit)carry;
+         r[i] = (Unit)t;
+         carry = (carry >> BitField::bits) + (t >> BitField::bits) +
+            (((unsigned NEXT_TYPE)x2 << BitField::bits) | x1);
+       }
+
+      delete [] c[0];
+    }
+
+#endif /* ! BIG_INT_QUAD_BYTE */
+
+    /*
+      r = a * b, for any an and bn greater than zero. r must not overlap
+      either a or b.
+    */
+   static void mulUnits (Unit * r, const Unit * a, long an,
+                         const Unit * b, long bn)
+    {
+      if (an < bn)
+       {
+         const Unit * t = a;
+         a = b;
+         b = t;
+
+         long tn = an;
+         an = bn;
+         bn = tn;
+       }
+
+      if (bn < KaratsubaCutoff)
+       {
+         mulSchool(r, a, an, b, bn);
+       }
+#ifndef BIG_INT_QUAD_BYTE
+      else if (useNtt(an, bn))
+       {
+         mulNtt(r, a, an, b, bn);
+       }
+#endif /* ! BIG_INT_QUAD_BYTE */
+      else if (an + 1 >= 2 * bn)
+       {
+          /* Unbalanced: multiply b by pieces of a that are as long as b. */
+         Unit * t = new Unit [2 * bn];
+         long i, piece;
+
+         std::memset(r, '\0', (an + bn) * sizeof(Unit));
+         for (i = 0; i < an; i += bn)
+          {
+            piece = (an - i < bn) ? an - i : bn;
+            mulUnits(t, a + i, piece, b, bn);
+            addInto(r + i, an + bn - i, t, piece + bn);
+          }
+
+         delete [] t;
+       }
+      else if ((bn < ToomCookCutoff) || (2 * an > 3 * bn))
+       {
+         mulKaratsuba(r, a, an, b, bn);
+       }
+      else
+       {
+         mulToomCook(r, a, an, b, bn);
+       }
+    }
+
+   void BitField::operator *= (const BitField & rhs)
+    {
+      if (Zero) return;
+      if (rhs.isZero())
+       {
+         Data->Refs--;
+         if (Data->Refs == 0) delete Data;
+
+         Data = NULL;
+         Zero = true;
+         return;
+       }
+
+      BitHolder * result = new BitHolder;
+      long length = Data->Length + rhs.Data->Length;
+
+      result->Data = new Unit [length];
+      result->Size = length;
+      result->Refs = 1;
+
+      mulUnits(result->Data, Data->Data, Data->Length,
+         rhs.Data->Data, rhs.Data->Length);
+
+      while (result->Data[length - 1] == 0) length--;
+      result->Length = length;
+
+       /* rhs may be this, so don't let go of our Data until now. */
+      Data->Refs--;
+      if (Data->Refs == 0) delete Data;
+      Data = result;
+    }
+
+
+
+    /*
+      Division of whole BitFields.
+
+      Integer used to do long division with the operators above: guess a
+      quotient digit from the top Units, then multiply, shift, compare, and
+      subtract whole BitFields. Like multiplication, this now works directly
+      on the Unit arrays. Below DivCutoff Units it is Knuth's Algorithm D.
+      Above that it is Burnikel and Ziegler's recursive division, which
+      turns most of the work into multiplications of half the size, and so
+      gets the benefit of Karatsuba, Toom-Cook, and NTT.
+
+      All of these expect a normalized divisor (the high bit of its top Unit
+      is set) of at least two Units, and a dividend whose top dn Units are
+      less than the divisor. The quotient is an - dn Units long, and the
+      remainder is left in the bottom dn Units of the dividend, with zeros
+      above it.
+    */
+   const static long DivCutoff = 32;
+
+    /* r = r - a * m, returns the borrow out. */
+   static Unit subMulUnit (Unit * r, const Unit * a, long n, Unit m)
+    {
+      unsigned NEXT_TYPE temp;
+      Unit borrow = 0, low;
+
+      for (long i = 0; i < n; i++)
+       {
+         temp = (unsigned NEXT_TYPE)a[i] * m + borrow;
+         low = (Unit)temp;
+         borrow = (Unit)(temp >> BitField::bits);
+         if (r[i] < low) borrow++;
+         r[i] -= low;
+       }
+
+      return borrow;
+    }
+
+   static int compareUnits (const Unit * a, const Unit * b, long n)
+    {
+      for (long i = n - 1; i >= 0; i--)
+       {
+         if (a[i] != b[i]) return (a[i] < b[i]) ? -1 : 1;
+       }
+      return 0;
+    }
+
+    /*
+      r = a << s, for 0 <= s < bits. Returns the bits shifted out the top.
+      r may be a.
+    */
+   static Unit shiftUnitsLeft (Unit * r, const Unit * a, long n, int s)
+    {
+      Unit carry = 0, temp;
+
+      if (s == 0)
+       {
+         std::memmove(r, a, n * sizeof(Unit));
+         return 0;
+       }
+
+      for (long i = 0; i < n; i++)
+       {
+         temp = a[i];
+         r[i] = (temp << s) | carry;
+         carry = temp >> (BitField::bits - s);
+       }
+
+      return carry;
+    }
+
+    /* r = a >> s, for 0 <= s < bits. r may be a. */
+   static void shiftUnitsRight (Unit * r, const Unit * a, long n, int s)
+    {
+      if (s == 0)
+       {
+         std::memmove(r, a, n * sizeof(Unit));
+         return;
+       }
+
+      for (long i = 0; i < n - 1; i++)
+         r[i] = (a[i] >> s) | (a[i + 1] << (BitField::bits - s));
+      r[n - 1] = a[n - 1] >> s;
+    }
+
+    /*
+      Knuth's Algorithm D. Each quotient digit is guessed from the top two
+      Units of the divisor and top three of the running remainder, which
+      Knuth shows is never more than one too large after the correction
+      loop. When it is, the subtraction borrows, and we add one divisor back.
+    */
+   static void divSchool (Unit * q, Unit * a, long an, const Unit * d, long dn)
+    {
+      Unit top = d[dn - 1], secd = d[dn - 2], qhat, rhat;
+      bool overflow;
+
+      for (long j = an - dn - 1; j >= 0; j--)
+       {
+          /* a[j + dn] can't be larger than top, as a[j + 1 .. j + dn] < d. */
+         if (a[j + dn] == top)
+          {
+            qhat = mask;
+            rhat = a[j + dn - 1] + top;
+            overflow = (rhat < top);
+          }
+         else
+          {
+            unsigned NEXT_TYPE num =
+               ((unsigned NEXT_TYPE)a[j + dn] << BitField::bits) | a[j + dn - 1];
+            qhat = (Unit)(num / top);
+            rhat = (Unit)(num % top);
+            overflow = false;
+          }
+
+         while (!overflow && ((unsigned NEXT_TYPE)qhat * secd >
+            (((unsigned NEXT_TYPE)rhat << BitField::bits) | a[j + dn - 2])))
+          {
+            qhat--;
+            rhat += top;
+            overflow = (rhat < top);
+          }
+
+         if (a[j + dn] < subMulUnit(a + j, d, dn, qhat))
+          {
+            qhat--;
+            addInto(a + j, dn, d, dn); // The carry out cancels the borrow.
+          }
+         a[j + dn] = 0;
+
+         q[j] = qhat;
+       }
+    }
+
+   static void divThreeByTwo (Unit *, Unit *, const Unit *, long);
+
+    /*
+      Divide the 2n Units of a by the n Units of d. This only recurses when
+      n is even, which BitField::operator /= arranges by padding the divisor.
+    */
+   static void divTwoByOne (Unit * q, Unit * a, const Unit * d, long n)
+    {
+      if ((n < DivCutoff) || (n & 1))
+       {
+         divSchool(q, a, 2 * n, d, n);
+         return;
+       }
+
+      long h = n / 2;
+      divThreeByTwo(q + h, a + h, d, h);
+      divThreeByTwo(q, a, d, h);
+    }
+
+    /*
+      Divide the 3h Units of a by the 2h Units of d, making h Units of
+      quotient. The guess from dividing the top 2h Units of a by the top h
+      Units of d is at most two too large.
+    */
+   static void divThreeByTwo (Unit * q, Unit * a, const Unit * d, long h)
+    {
+      const Unit * d1 = d + h;
+      const Unit one = 1;
+      Unit * t = new Unit [2 * h];
+      long over = 0;
+
+      if (compareUnits(a + 2 * h, d1, h) < 0)
+       {
+         divTwoByOne(q, a + h, d1, h);
+       }
+      else
+       {
+          /*
+            The top of a equals d1. Guess all ones, and then the first
+            remainder is a1 + d1, which may carry.
+          */
+         for (long i = 0; i < h; i++) q[i] = mask;
+         over = (long)addInto(a + h, h, d1, h);
+         std::memset(a + 2 * h, '\0', h * sizeof(Unit));
+       }
+
+      mulUnits(t, q, h, d, h);
+      over -= (long)subFrom(a, 2 * h, t, 2 * h);
+      while (over < 0)
+       {
+         subFrom(q, h, &one, 1);
+         over += (long)addInto(a, 2 * h, d, 2 * h);
+       }
+
+      delete [] t;
+    }
+
+    /* The general case: an - dn Units of quotient. */
+   static void divUnits (Unit * q, Unit * a, long an, const Unit * d, long dn)
+    {
+      long qn = an - dn;
+
+      if ((dn < DivCutoff) || (qn < DivCutoff))
+       {
+         divSchool(q, a, an, d, dn);
+         return;
+       }
+
+       /* Take dn Units of quotient at a time, from the top. */
+      while (qn >= dn)
+       {
+         qn -= dn;
+         divTwoByOne(q + qn, a + qn, d, dn);
+       }
+
+      if (qn == 0) return;
+
+      if (qn < DivCutoff)
+       {
+         divSchool(q, a, qn + dn, d, dn);
+         return;
+       }
+
+       /*
+         Pad what is left with leading zeros to a full block, rather than
+         write another algorithm for the short end.
+       */
+      Unit * t = new Unit [3 * dn];
+
+      std::memcpy(t, a, (qn + dn) * sizeof(Unit));
+      std::memset(t + qn + dn, '\0', (dn - qn) * sizeof(Unit));
+
+      divTwoByOne(t + 2 * dn, t, d, dn);
+
+      std::memcpy(q, t + 2 * dn, qn * sizeof(Unit));
+      std::memcpy(a, t, dn * sizeof(Unit));
+      std::memset(a + dn, '\0', qn * sizeof(Unit));
+
+      delete [] t;
+    }
+
+    /*
+      this = this / rhs, returns this % rhs. Division by zero is the
+      caller's problem.
+    */
+   BitField BitField::operator /= (const BitField & rhs)
+    {
+      BitField remainder;
+
+      if (Zero) return remainder;
+
+      if (rhs.Data->Length == 1)
+       {
+         remainder = BitField(operator /= (rhs.Data->Data[0]));
+         return remainder;
+       }
+
+      if (compare(rhs) < 0)
+       {
+         remainder = *this;
+         Data->Refs--;
+         if (Data->Refs == 0) delete Data;
+
+         Data = NULL;
+         Zero = true;
+         return remainder;
+       }
+
+      long an = Data->Length, dn = rhs.Data->Length, pad = 0, i;
+      int shift = (int)(bits - 1 - rhs.msb() % bits);
+      Unit * a, * d;
+
+       /*
+         The recursive algorithm wants a divisor that is a small number of
+         Units times a power of two. Appending zero Units to both numbers
+         doesn't change the quotient.
+       */
+      if ((dn >= DivCutoff) && (an + 1 - dn >= DivCutoff))
+       {
+         long blocks = dn, scale = 1;
+         while (blocks >= DivCutoff)
+          {
+            blocks = (blocks + 1) / 2;
+            scale *= 2;
+          }
+         pad = blocks * scale - dn;
+       }
+
+       /* The extra Unit on a keeps its top dn Units less than d. */
+      a = new Unit [pad + an + 1];
+      d = new Unit [pad + dn];
+      std::memset(a, '\0', pad * sizeof(Unit));
+      std::memset(d, '\0', pad * sizeof(Unit));
+      a[pad + an] = shiftUnitsLeft(a + pad, Data->Data, an, shift);
+      shiftUnitsLeft(d + pad, rhs.Data->Data, dn, shift);
+
+      BitHolder * quotient = new BitHolder;
+      long length = an + 1 - dn;
+
+      quotient->Data = new Unit [length];
+      quotient->Size = length;
+      quotient->Refs = 1;
+
+      divUnits(quotient->Data, a, pad + an + 1, d, pad + dn);
+
+      while (quotient->Data[length - 1] == 0) length--;
+      quotient->Length = length;
+
+       /* The remainder is in a, but still shifted. */
+      shiftUnitsRight(a + pad, a + pad, dn, shift);
+      for (i = dn; (i > 0) && (a[pad + i - 1] == 0); i--) ;
+      if (i > 0)
+       {
+         remainder.Data = new BitHolder;
+         remainder.Data->Data = new Unit [i];
+         remainder.Data->Size = i;
+         remainder.Data->Length = i;
+         remainder.Data->Refs = 1;
+         std::memcpy(remainder.Data->Data, a + pad, i * sizeof(Unit));
+         remainder.Zero = false;
+       }
+
+      delete [] a;
+      delete [] d;
+
+       /* rhs may be this, so don't let go of our Data until now. */
+      Data->Refs--;
+      if (Data->Refs == 0) delete Data;
+      Data = quotient;
+
+      return remainder;
+    }
+
+
+
    int BitField::compare (const BitField & rhs) const
     {
       if (Zero && rhs.isZero()) return 0;
@@ -893,55 +1907,6 @@ namespace BigInt
 
 
 
-    /*
-      This is here because Integer::divmod has no idea what NEXT_TYPE is.
-      shortGuess handles a strange bug in division: see division code.
-
-      From Knuth, TAOCP vol. 2:
-         approx is at most off by 2
-         tempering will solve ALL instances off by 1 and most off by 2
-    */
-   Unit BitField::divApprox (Unit divisor, Unit sec, bool shortGuess) const
-    {
-      if (Zero) return 0;
-
-      Unit approx;
-      unsigned NEXT_TYPE lhs, rhs, temp;
-
-       /*
-         Handle the need for a leading zero.
-         Risk generating a leading zero to ensure that a leading 1 isn't
-         dropped.
-       */
-      if (shortGuess)
-       {
-         approx = Data->Data[Data->Length - 1] / divisor;
-         temp = approx;
-
-         rhs = (((unsigned NEXT_TYPE)Data->Data[Data->Length - 1] %
-            divisor) << bits) | Data->Data[Data->Length - 2];
-       }
-      else
-       {
-         temp = (((unsigned NEXT_TYPE)Data->Data[Data->Length - 1] << bits) |
-            Data->Data[Data->Length - 2]) / divisor;
-         approx = (Unit)temp;
-
-         rhs = (((((unsigned NEXT_TYPE)Data->Data[Data->Length - 1] << bits) |
-            Data->Data[Data->Length - 2]) % divisor) << bits) |
-            Data->Data[Data->Length - 3];
-       }
-
-      lhs = (unsigned NEXT_TYPE)approx * sec;
-
-      if (approx != temp) approx = ((Unit)-1);
-      else if (lhs > rhs) approx--;
-
-      return approx;
-    }
-
-
-
     /*
       One's complement. I don't like how it works, but c'est la vie.
     */
@@ -108,6 +108,9 @@ namespace BigInt
          void operator *= (Unit);
          Unit operator /= (Unit);
 
+         void operator *= (const BitField &);
+         BitField operator /= (const BitField &);
+
          void operator = (const BitField &);
 
          bool isZero (void) const
@@ -122,8 +125,6 @@ namespace BigInt
 
          Unit getDigit (long) const;
 
-         Unit divApprox (Unit, Unit, bool) const;
-
          bool operator > (const BitField &) const;
          bool operator < (const BitField &) const;
          bool operator >= (const BitField &) const;
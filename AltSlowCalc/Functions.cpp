@@ -339,8 +339,12 @@ namespace BigInt
             temp *= one; //which is now ln(10)
             res += temp;
             break;
-         case 2:
-            temp = Float(Integer((long long) opp.Exponent).toString() + ".5");
+         case 2: //For y < 0, y + .5 is -(-y - 1).5
+            if (opp.Exponent < 0)
+               temp = Float("-" +
+                  Integer((long long) (-opp.Exponent - 1)).toString() + ".5");
+            else
+               temp = Float(Integer((long long) opp.Exponent).toString() + ".5");
             one = M_LN10;
 
             temp *= one;
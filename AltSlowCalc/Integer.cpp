@@ -27,6 +27,7 @@ OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
 SUCH DAMAGE.
 */
 
+#include <vector>
 #include "Integer.hpp"
 
 namespace BigInt
@@ -336,14 +337,13 @@ namespace BigInt
     }
 
     /*
-      This is the standard O(n^2) algorithm for multiplication.
-      Karatsuba multiplication is not implemented, nor anything faster.
+      The single Unit cases are handled here, as they are the most common.
+      Everything else is handed to BitField, which chooses between long
+      multiplication, Karatsuba, and Toom-Cook based on the sizes.
     */
    Integer operator * (const Integer & lhs, const Integer & rhs)
     {
       Integer result;
-      BitField temp;
-      long i;
 
        // 0 * x = x * 0 = 0
       if (lhs.isZero() || rhs.isZero()) return result;
@@ -366,27 +366,8 @@ namespace BigInt
          return result;
        }
 
-       //Do long multiplication.
-      if (rhs.Digits.length() >= lhs.Digits.length())
-       { //iterate over lhs, as it is smaller
-         for (i = 0; i < lhs.Digits.length(); i++)
-          {
-            temp = rhs.Digits;
-            temp *= lhs.Digits.getDigit(i); //We should save time by putting
-            temp <<= i * BitField::bits; //the multiply before the shift.
-            result.Digits += temp;
-          }
-       }
-      else
-       { //iterate over rhs, as it is smaller
-         for (i = 0; i < rhs.Digits.length(); i++)
-          {
-            temp = lhs.Digits;
-            temp *= rhs.Digits.getDigit(i);
-            temp <<= i * BitField::bits;
-            result.Digits += temp;
-          }
-       }
+      result.Digits = lhs.Digits;
+      result.Digits *= rhs.Digits;
 
       return result;
     }
@@ -578,80 +559,105 @@ namespace BigInt
 
 
 
-   void Integer::fromString (const std::string & src, int base)
-    {
-      fromString(src.c_str(), base);
-    }
+    /*
+      Conversion of big numbers is done by divide and conquer. A string of
+      digits is split in two at a power of the base, each half is converted
+      separately, and the halves are put back together with one
+      multiplication or division. The powers are base^(maxdigits * 2^k),
+      computed by squaring once per conversion and shared by every level of
+      the recursion. That makes the cost of conversion a small multiple of
+      the cost of the largest multiplication or division, instead of
+      quadratic in the number of digits.
+
+      Below ConvCutoff Units, the digit packing code is used directly.
+    */
+   const static long ConvCutoff = 24;
 
-   void Integer::fromString (const char * src, int base)
+   static int digitValue (char curchar, int base)
     {
-      int curchar, digits;
-      Unit fatdigit, power;
-      const char * iter = src;
-      bool done = false;
+      int result;
+
+      if ((curchar >= '0') && (curchar <= '9')) //Only handles ASCII
+         result = curchar - '0';
+      else if ((curchar >= 'A') && (curchar <= 'Z'))
+         result = curchar - 'A' + 10;
+      else if ((curchar >= 'a') && (curchar <= 'z'))
+         result = curchar - 'a' + 10;
+      else
+         return -1;
 
-      if ((base < 2) || (base > 36)) return;
+       /*
+         Adopt the bc model, so that 'zzz' is the largest 3 digit number
+         invariant of base.
+       */
+      if (result >= base) result = base - 1;
 
-      if (*iter == '-')
-       {
-         Sign = true;
-         iter++;
-       }
-      else if (*iter == '+')
+      return result;
+    }
+
+    /* Fill in bigPowers[k] = base^(maxdigits * 2^k), up to and including k. */
+   static void makePowers (std::vector<BitField> & bigPowers, int base, long k)
+    {
+      if (bigPowers.empty()) bigPowers.push_back(BitField(powers[base - 2]));
+      while ((long)bigPowers.size() <= k)
        {
-         Sign = false;
-         iter++;
+         bigPowers.push_back(bigPowers.back());
+         bigPowers.back() *= bigPowers.back();
        }
-      else Sign = false;
+    }
 
-      Digits = BitField();
+    /* Convert the len digits at src, which are all valid digits. */
+   static BitField fromDigits (const char * src, long len, int base,
+                               std::vector<BitField> & bigPowers)
+    {
+      BitField result;
+      long k = 0, low = maxdigits[base - 2];
 
-       /*
-         This digit packing algorithm should save alot of time for big
-         numbers, and shouldn't add appreciable time to small numbers.
-       */
-      for (; !done && (*iter != '\0');)
+      if (len < ConvCutoff * maxdigits[base - 2])
        {
-         digits = maxdigits[base - 2];
-         fatdigit = 0;
-         power = 1;
+          /*
+            This digit packing algorithm should save alot of time for big
+            numbers, and shouldn't add appreciable time to small numbers.
+          */
+         const char * end = src + len;
+         int digits;
+         Unit fatdigit, power;
 
-         for (; (*iter != '\0') && digits; iter++, digits--)
+         while (src != end)
           {
-            curchar = *iter;
-
-            if ((curchar >= '0') && (curchar <= '9')) //Only handles ASCII
-               curchar = curchar - '0';
-            else if ((curchar >= 'A') && (curchar <= 'Z'))
-               curchar = curchar - 'A' + 10;
-            else if ((curchar >= 'a') && (curchar <= 'z'))
-               curchar = curchar - 'a' + 10;
-            else
-             {
-               done = true;
-               break;
-             }
+            digits = maxdigits[base - 2];
+            fatdigit = 0;
+            power = 1;
 
-             /*
-               Adopt the bc model, so that 'zzz' is the largest 3 digit number
-               invariant of base.
-             */
-            if (curchar >= base) curchar = base - 1;
+            for (; (src != end) && digits; src++, digits--)
+             {
+               fatdigit *= base;
+               fatdigit += digitValue(*src, base);
 
-            fatdigit *= base;
-            fatdigit += curchar;
+               power *= base;
+             }
 
-            power *= base;
+            result *= power;
+            result += fatdigit;
           }
 
-         Digits *= power;
-         Digits += fatdigit;
+         return result;
        }
 
-      if (isZero()) Sign = false;
-    }
+       /* Split off the largest block of low digits shorter than len. */
+      while (2 * low < len)
+       {
+         low *= 2;
+         k++;
+       }
+      makePowers(bigPowers, base, k);
 
+      result = fromDigits(src, len - low, base, bigPowers);
+      result *= bigPowers[k];
+      result += fromDigits(src + len - low, low, base, bigPowers);
 
+      return result;
+    }
 
     /*
       Digit packing is NECESSARY for toString to be efficient.
@@ -668,14 +674,108 @@ namespace BigInt
          32787 * 35073 / 2 or about 574969225 divides. We have decreased the
          number of divides by almost an order of magnitude.
     */
+    /*
+      Append the digits of src to result, with leading zeros out to width
+      digits.
+    */
+   static void toDigits (const BitField & src, int base, long width,
+                         std::vector<BitField> & bigPowers, std::string & result)
+    {
+      const char table [] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+      if (src.length() < ConvCutoff)
+       {
+         BitField cpy (src);
+         std::string temp;
+         Unit digit;
+         int d;
+
+          /* The digits come out backwards. */
+         while (!cpy.isZero())
+          {
+            digit = (cpy /= powers[base - 2]);
+
+            for (d = maxdigits[base - 2]; d > 0; d--)
+             {
+               temp += table[digit % base];
+               digit /= base;
+             }
+          }
+
+         while (!temp.empty() && (temp[temp.length() - 1] == '0'))
+            temp.erase(temp.length() - 1);
+         if ((long)temp.length() < width)
+            temp.append(width - temp.length(), '0');
+
+         result.append(temp.rbegin(), temp.rend());
+         return;
+       }
+
+       /*
+         Split at the largest power that is no bigger than src. Both the
+         quotient and the remainder are then less than that power.
+       */
+      long k = 0, low = maxdigits[base - 2];
+
+      makePowers(bigPowers, base, 0);
+      while (true)
+       {
+          /* Don't square a power that is obviously big enough already. */
+         if (2 * bigPowers[k].length() - 2 >= src.length()) break;
+         makePowers(bigPowers, base, k + 1);
+         if (bigPowers[k + 1].compare(src) > 0) break;
+         low *= 2;
+         k++;
+       }
+
+      BitField quot (src), rem;
+      rem = (quot /= bigPowers[k]);
+
+      toDigits(quot, base, (width > low) ? width - low : 0, bigPowers, result);
+      toDigits(rem, base, low, bigPowers, result);
+    }
+
+
+
+   void Integer::fromString (const std::string & src, int base)
+    {
+      fromString(src.c_str(), base);
+    }
+
+   void Integer::fromString (const char * src, int base)
+    {
+      const char * iter = src;
+      std::vector<BitField> bigPowers;
+      long len = 0;
+
+      if ((base < 2) || (base > 36)) return;
+
+      if (*iter == '-')
+       {
+         Sign = true;
+         iter++;
+       }
+      else if (*iter == '+')
+       {
+         Sign = false;
+         iter++;
+       }
+      else Sign = false;
+
+       /* Conversion stops at the first thing that isn't a digit. */
+      while (digitValue(iter[len], base) >= 0) len++;
+
+      Digits = fromDigits(iter, len, base, bigPowers);
+
+      if (isZero()) Sign = false;
+    }
+
+
+
    std::string Integer::toString (int base) const
     {
       std::string result;
-      BitField cpy (Digits);
-      Unit digit;
-      char table [] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ", * temp = NULL;
-      int i, d;
-      const int buffsize = 2048;
+      std::vector<BitField> bigPowers;
 
       if ((base < 2) || (base > 36))
        {
@@ -687,45 +787,8 @@ namespace BigInt
        }
       else
        {
-         temp = new char [buffsize];
-         temp [buffsize - 1] = '\0';
-         i = buffsize - 2;
-         while (!cpy.isZero())
-          {
-            digit = (cpy /= powers[base - 2]);
-            d = maxdigits[base - 2];
-
-            while (d--)
-             {
-               temp[i--] = table[digit % base];
-               digit /= base;
-               if (i == -1)
-                {
-                  if (cpy.isZero() && (digit == 0))
-                   {
-                     i++;
-                     while (temp[i] == '0') i++;
-                     result = (temp + i) + result;
-                     i = buffsize - 2;
-                     break;
-                   }
-                  else
-                   {
-                     result = temp + result;
-                     i = buffsize - 2;
-                   }
-                }
-             }
-          }
-         if (i != (buffsize - 2))
-          {
-            i++;
-            while (temp[i] == '0') i++;
-            result = (temp + i) + result;
-          }
-         if (isSigned()) result = "-" + result;
-         delete [] temp;
-         temp = NULL;
+         if (isSigned()) result = "-";
+         toDigits(Digits, base, 0, bigPowers, result);
        }
 
       return result;
@@ -737,10 +800,8 @@ namespace BigInt
                          Integer & q, Integer & r)
     {
       Integer dd (lhs) /* DividenD */, dr (rhs) /* DivisoR */;
-      BitField temp, subr;
-      Unit smallr, test, top, secd;
-      int oneCompare, shift;
-      long digit;
+      Unit smallr;
+      int oneCompare;
 
        // Zero divided by zero?!... Do NOTHING!!!!!
       if (dd.isZero() && dr.isZero()) return;
@@ -798,84 +859,11 @@ namespace BigInt
          return;
        }
 
-       //Our only choice now is long division.
-       /*
-         Let's implement Knuth's Division.
-         I don't think I understood this reading it in TAOCP. I had to read
-         several implementations to get it right.
-
-         I find it best to actually try this out on paper to see how it
-         works.
-         Take 12|34|56|78 / 17|69
-         1234 / 17 = 72          1769 * 72 * 100 = 12736800
-                                 1769 * 71 * 100 = 12559900
-                                 1769 * 70 * 100 = 12383000
-                                 1769 * 69 * 100 = 12206100
-         12345678 - 12206100 = 139578
-         1395 / 17 = 82          1769 * 82 * 1 = 145058
-                                 1769 * 81 * 1 = 143289
-                                 1769 * 80 * 1 = 141520
-                                 1769 * 79 * 1 = 139751
-                                 1769 * 78 * 1 = 137982
-         139578 - 137982 = 1596
-         Quotient = 6978 (69|78) Remainder = 1596
-       */
-      q.Digits = BitField();
-
-       //we normalize dr so that it's msb is bit 31
-      shift = BitField::bits - dr.Digits.msb() % BitField::bits - 1;
-
-       //shift up our divisor and dividend
-      dr.Digits <<= shift;
-      dd.Digits <<= shift;
-
-       //get the most significant units of the divisor
-      top = dr.Digits.getDigit(dr.Digits.length() - 1);
-      secd = dr.Digits.getDigit(dr.Digits.length() - 2);
-
-       //get the place value of the first digit
-       //Generate alot of leading zeros to make sure that
-       //we never lose a leading one.
-      digit = dd.Digits.length() - dr.Digits.length();
-
-       // subr will hold the shifted divisor
-      subr = dr.Digits;
-      subr <<= digit * BitField::bits;
-
-      while (digit >= 0)
-       {
-          //first, compute an approximation of the current digit of q
-         test = dd.Digits.divApprox(top, secd,
-          //If the lengths are equal, we have the possibility of generating
-          //a guess that is astronomically higher than it should be,
-          //effectively causing the program to hang. Very obscure bug.
-            dd.Digits.length() < (dr.Digits.length() + digit + 1));
-         temp = dr.Digits;
-         temp *= test;
-         temp <<= digit * BitField::bits;
-
-          //make sure our approximation isn't too high
-         if (temp > dd.Digits)
-          {
-            test--;
-            temp -= subr;
-          }
-
-          //add to quotient, and subtract from running remainder
-         q.Digits <<= BitField::bits;
-         q.Digits += test;
-         dd.Digits -= temp;
-
-          // shift down our shifted divisor and decrement the place value
-         subr >>= BitField::bits;
-         digit--;
-       }
-
-       //assign the remainder to r
-      r.Digits = dd.Digits;
-
-       //shift remainder back down
-      r.Digits >>= shift;
+       //Our only choice now is long division, which BitField does for us.
+       //It uses Knuth's Algorithm D, or Burnikel and Ziegler's recursive
+       //division when the numbers are large.
+      r.Digits = (dd.Digits /= dr.Digits);
+      q.Digits = dd.Digits;
 
        //don't let either result be -0
       if (q.Digits.isZero()) q.Sign = false; //q should never be 0 here
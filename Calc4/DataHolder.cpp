@@ -30,6 +30,8 @@ SUCH DAMAGE.
 #include "Float.hpp"
 #include "DataHolder.hpp"
 #include <cmath>
+#include <map>
+#include <vector>
 
 namespace DecFloat
  {
@@ -158,6 +160,63 @@ namespace DecFloat
       mpfr_clear(Data);
     }
 
+
+   // The freelist: released DataHolders, their mpfr_t still initialized,
+   // by precision, so that build and own skip mpfr_init2 and mpfr_clear.
+   // It is never destroyed, as static Floats may be released after it.
+   static const size_t freeListDepth = 64U;
+
+   typedef std::map<unsigned long, std::vector<DataHolder *> > FreeList;
+
+   static FreeList & freeList (void)
+    {
+      static FreeList * instance = new FreeList;
+      return *instance;
+    }
+
+   DataHolder * DataHolder::recycle (unsigned long prec)
+    {
+      DataHolder * result = NULL;
+//Lock Mutex
+      FreeList::iterator bucket = freeList().find(prec);
+      if ((bucket != freeList().end()) && !bucket->second.empty())
+       {
+         result = bucket->second.back();
+         bucket->second.pop_back();
+         result->Refs = 1;
+       }
+//Unlock Mutex
+      return result;
+    }
+
+   void DataHolder::retire (void)
+    {
+      bool kept = false;
+//Lock Mutex
+      std::vector<DataHolder *> & bucket = freeList()[precision];
+      if (bucket.size() < freeListDepth)
+       {
+         bucket.push_back(this);
+         kept = true;
+       }
+//Unlock Mutex
+      if (!kept)
+       {
+         delete this;
+       }
+    }
+
+   DataHolder * DataHolder::build (unsigned long prec)
+    {
+      DataHolder * result = recycle(prec);
+      if (result == NULL)
+       {
+         return new DataHolder (prec);
+       }
+      mpfr_set_d(result->Data, 0.0, GMP_RNDN);
+      return result;
+    }
+
    DataHolder * DataHolder::ref (void) const
     {
 //Lock Mutex
@@ -173,7 +232,7 @@ namespace DecFloat
 //Unlock Mutex
       if (res == 0)
        {
-         delete this;
+         retire();
        }
     }
 
@@ -184,9 +243,17 @@ namespace DecFloat
       if (Refs != 1)
        {
          --Refs;
-         newThis = new DataHolder(*this);
+         newThis = NULL;
        }
 //Unlock Mutex
+      if (newThis == NULL)
+       {
+         newThis = recycle(precision);
+         if (newThis == NULL)
+            newThis = new DataHolder(*this);
+         else
+            mpfr_set(newThis->Data, Data, GMP_RNDN);
+       }
       return newThis;
     }
 
@@ -54,10 +54,15 @@ namespace DecFloat
          DataHolder (const std::string &, unsigned long);
          ~DataHolder ();
 
+         // A DataHolder losing its last reference is kept on a freelist
+         // for the next build or own of the same precision.
+         static DataHolder * recycle (unsigned long);
+         void retire (void);
+
       public:
          static DataHolder * build (const std::string & src, unsigned long usePrec = 0)
           { return new DataHolder (src, usePrec); }
-         static DataHolder * build (unsigned long prec) { return new DataHolder (prec); }
+         static DataHolder * build (unsigned long prec);
          static DataHolder & ZERO (void);
 
          DataHolder * ref (void) const;
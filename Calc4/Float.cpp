@@ -230,29 +230,53 @@ namespace DecFloat
     }
 
 
+   // The compound operators compute in place when this Float is the only
+   // reference to its DataHolder and rhs has no more precision, so that the
+   // result has this one's. MPFR allows the result to be an operand.
+   bool Float::reusable (const Float & rhs) const
+    {
+      return (Data->getInternal() != NULL) &&
+         (Data->getPrecision() >= rhs.Data->getPrecision());
+    }
+
    Float & Float::operator += (const Float & rhs)
     {
-      return (*this = *this + rhs);
+      if (!reusable(rhs))
+         return (*this = *this + rhs);
+      mpfr_add(Data->getInternal(), Data->get(), rhs.Data->get(), roundModes[roundMode]);
+      return *this;
     }
 
    Float & Float::operator -= (const Float & rhs)
     {
-      return (*this = *this - rhs);
+      if (!reusable(rhs))
+         return (*this = *this - rhs);
+      mpfr_sub(Data->getInternal(), Data->get(), rhs.Data->get(), roundModes[roundMode]);
+      return *this;
     }
 
    Float & Float::operator *= (const Float & rhs)
     {
-      return (*this = *this * rhs);
+      if (!reusable(rhs))
+         return (*this = *this * rhs);
+      mpfr_mul(Data->getInternal(), Data->get(), rhs.Data->get(), roundModes[roundMode]);
+      return *this;
     }
 
    Float & Float::operator /= (const Float & rhs)
     {
-      return (*this = *this / rhs);
+      if (!reusable(rhs))
+         return (*this = *this / rhs);
+      mpfr_div(Data->getInternal(), Data->get(), rhs.Data->get(), roundModes[roundMode]);
+      return *this;
     }
 
    Float & Float::operator %= (const Float & rhs)
     {
-      return (*this = *this % rhs);
+      if (!reusable(rhs))
+         return (*this = *this % rhs);
+      mpfr_remainder(Data->getInternal(), Data->get(), rhs.Data->get(), roundModes[roundMode]);
+      return *this;
     }
 
 
@@ -79,6 +79,9 @@ namespace DecFloat
          // we would just need to copy the mpfr_t
          // and re-add the sign every operation.
 
+         // Can a compound operator with this rhs write into Data?
+         bool reusable (const Float &) const;
+
       public:
          Float ();
          Float (const Float &);
@@ -37,9 +37,7 @@ namespace BigInt
 
    Float pi (unsigned long precision)
     {
-      Float pi(M_PI);
-      pi.setPrecision(precision);
-      return pi;
+      return constant(CONST_PI, precision);
     }
 
    long fromFloat (const Float & src)
@@ -388,6 +388,13 @@ void Calculator::doStuff (string doThis)
     {
       help();
     }
+   else if (doThis == "allocs")
+    {
+      unsigned long hits, misses;
+      Column::poolStatistics(hits, misses);
+      cout << "Digit arrays: " << misses << " from the heap, "
+           << hits << " reused" << endl;
+    }
    else
     {
       left = Float(doThis);
@@ -29,6 +29,21 @@
 #include "Column.hpp"
 #include <cstring>
 
+/*
+   Digit adds and subtracts run sixteen (SSE2) or thirty-two (AVX2) digits
+   at a time on x86, AVX2 being chosen at run time. COLUMN_SCALAR leaves
+   only the digit-at-a-time loop, and COLUMN_NO_AVX2 stops at SSE2, so
+   that the kernels can be compared.
+*/
+#if !defined(COLUMN_PACKED) && !defined(COLUMN_SCALAR) && defined(__GNUC__) && \
+   defined(__SSE2__) && (defined(__x86_64__) || defined(__i386__))
+ #define COLUMN_SIMD
+ #include <immintrin.h>
+ #ifndef COLUMN_NO_AVX2
+  #define COLUMN_AVX2
+ #endif /* ! COLUMN_NO_AVX2 */
+#endif
+
 using std::memcpy;
 using std::memmove;
 using std::memset;
@@ -73,6 +88,106 @@ namespace Col
       return (minLength = newLength);
     }
 
+/*
+==============================================================================
+   The digit array pool
+------------------------------------------------------------------------------
+   NOTES:
+      Every Float operation copies its arguments and makes several scratch
+      Columns, all of a few lengths fixed by the precision, so digit arrays
+      are made and thrown away constantly. Arrays are kept by size class:
+      class c holds blocks of MinPoolBytes << c bytes, linked through their
+      first bytes. An array too big for the last class comes from the heap.
+
+      A class keeps at most PoolClassBytes of blocks, or PoolMinBlocks
+      blocks if those are bigger, and gives the rest back to the heap.
+
+      SlowCalc is single threaded, so the pool is not locked.
+==============================================================================
+*/
+   static const int PoolClasses = 24;
+   static const std::size_t MinPoolBytes = 16;
+   static const std::size_t PoolClassBytes = 1024 * 1024;
+   static const long PoolMinBlocks = 8;
+
+   static void * poolHeads [PoolClasses];
+   static long poolCounts [PoolClasses];
+   static unsigned long poolHits = 0, poolMisses = 0;
+
+   static int poolClass (std::size_t bytes)
+    {
+      int c = 0;
+      while ((c < PoolClasses) && ((MinPoolBytes << c) < bytes)) c++;
+      return c;
+    }
+
+/*
+==============================================================================
+   Function: grab
+------------------------------------------------------------------------------
+   OUTPUT: an uninitialized array of at least bytes bytes
+==============================================================================
+*/
+   void * Column::grab (std::size_t bytes)
+    {
+      int c = poolClass(bytes);
+      if (c == PoolClasses)
+       {
+         poolMisses++;
+         return ::operator new (bytes);
+       }
+      void * block = poolHeads[c];
+      if (block == NULL)
+       {
+         poolMisses++;
+         return ::operator new (MinPoolBytes << c);
+       }
+      poolHeads[c] = *static_cast<void **>(block);
+      poolCounts[c]--;
+      poolHits++;
+      return block;
+    }
+
+/*
+==============================================================================
+   Function: drop
+------------------------------------------------------------------------------
+   NOTES:
+      bytes must be what the array was grabbed with.
+==============================================================================
+*/
+   void Column::drop (void * block, std::size_t bytes)
+    {
+      if (block == NULL) return;
+      int c = poolClass(bytes);
+      if ((c == PoolClasses) || ((poolCounts[c] >= PoolMinBlocks) &&
+          ((poolCounts[c] + 1) * (MinPoolBytes << c) > PoolClassBytes)))
+       {
+         ::operator delete (block);
+         return;
+       }
+      *static_cast<void **>(block) = poolHeads[c];
+      poolHeads[c] = block;
+      poolCounts[c]++;
+    }
+
+/*
+==============================================================================
+   Function: poolStatistics
+------------------------------------------------------------------------------
+   NOTES:
+      A miss is a trip to the heap.
+==============================================================================
+*/
+   void Column::poolStatistics (unsigned long & hits, unsigned long & misses)
+    {
+      hits = poolHits;
+      misses = poolMisses;
+    }
+
+   /* PackedColumn.cpp holds the rest of Column when it is packed. */
+#ifndef COLUMN_PACKED
+
 /*
 ==============================================================================
    Function: no argument Column constructor
@@ -91,7 +206,7 @@ namespace Col
 */
    Column::~Column ()
     {
-      if (Digits != NULL) delete [] Digits;
+      if (Digits != NULL) drop(Digits, Length);
       Digits = NULL;
     }
 
@@ -112,7 +227,7 @@ namespace Col
        }
       else //Allocate Digits and copy the payload
        {
-         Digits = new char [src.Length];
+         Digits = static_cast<char *>(grab(src.Length));
          memcpy(Digits, src.Digits, src.Length);
          Sign = src.Sign;
          Length = src.Length;
@@ -152,7 +267,7 @@ namespace Col
          int tempLength = p - src;
          if (tempLength < minLength) Length = minLength;
          else Length = tempLength;
-         Digits = new char [Length];
+         Digits = static_cast<char *>(grab(Length));
          memset(Digits, 0, Length);
          int i;
          for (i = 0; i < tempLength; i++) Digits[i] = src[i] - '0';
@@ -160,7 +275,7 @@ namespace Col
          if (i == Length) //We are zero
           {
             Zero = true;
-            delete [] Digits;
+            drop(Digits, Length);
             Digits = NULL;
           }
          else Zero = false;
@@ -196,7 +311,7 @@ namespace Col
     {
       if (Digits != NULL)
        {
-         delete [] Digits;
+         drop(Digits, Length);
          Digits = NULL;
        }
       Zero = true;
@@ -221,7 +336,7 @@ namespace Col
        {
          if (Digits != NULL)
           {
-            delete [] Digits;
+            drop(Digits, Length);
             Digits = NULL;
           }
          Zero = true;
@@ -233,7 +348,7 @@ namespace Col
       if (i == Length) //number is zero
        {
          Zero = true;
-         delete [] Digits;
+         drop(Digits, Length);
          Digits = NULL;
        }
     } //setToZero (int, int)
@@ -249,11 +364,11 @@ namespace Col
       else
        {
          int newLength = Length + delta;
-         char * newDigits = new char [newLength];
+         char * newDigits = static_cast<char *>(grab(newLength));
          memcpy(newDigits, Digits, Length);
          memset(newDigits + Length, 0, delta);
+         drop(Digits, Length);
          Length = newLength;
-         delete [] Digits;
          Digits = newDigits;
        }
       return Length;
@@ -277,10 +392,10 @@ namespace Col
          if (newLength < minLength) newLength = minLength;
          if (newLength != Length)
           {
-            char * newDigits = new char [newLength];
+            char * newDigits = static_cast<char *>(grab(newLength));
             memcpy(newDigits, Digits, newLength);
+            drop(Digits, Length);
             Length = newLength;
-            delete [] Digits;
             Digits = newDigits;
           }
        }
@@ -298,15 +413,15 @@ namespace Col
       if (Zero) Length = absolute;
       else if (absolute != Length)
        {
-         char * newDigits = new char [absolute];
+         char * newDigits = static_cast<char *>(grab(absolute));
          if (absolute > Length)
           {
             memcpy(newDigits, Digits, Length);
             memset(newDigits + Length, 0, absolute - Length);
           }
          else memcpy(newDigits, Digits, absolute);
+         drop(Digits, Length);
          Length = absolute;
-         delete [] Digits;
          Digits = newDigits;
        }
       return Length;
@@ -459,7 +574,7 @@ namespace Col
       if (shift > Length)
        {
          Zero = true;
-         delete [] Digits;
+         drop(Digits, Length);
          Digits = NULL;
        }
       else
@@ -469,7 +584,7 @@ namespace Col
          if (i == Length) //Yes: number is zero
           {
             Zero = true;
-            delete [] Digits;
+            drop(Digits, Length);
             Digits = NULL;
           }
          else //No: actually move the data
@@ -495,7 +610,7 @@ namespace Col
       if (shift > Length)
        {
          Zero = true;
-         delete [] Digits;
+         drop(Digits, Length);
          Digits = NULL;
        }
       else
@@ -505,7 +620,7 @@ namespace Col
          if (i == (Length - shift)) //Yes: number is zero
           {
             Zero = true;
-            delete [] Digits;
+            drop(Digits, Length);
             Digits = NULL;
           }
          else //No: actually move the data
@@ -548,13 +663,192 @@ namespace Col
       if (Zero && (value == 0)) return 0;
       if (Zero)
        {
-         Digits = new char [Length];
+         Digits = static_cast<char *>(grab(Length));
          memset(Digits, 0, Length);
          Zero = false;
        }
       return static_cast<int>((Digits[index] = static_cast<char>(value)));
     }
 
+#ifdef COLUMN_SIMD
+   //32 zeros, then 32 ones: loading from fillBytes + 32 - width + d
+   //gives a vector with its last d bytes set
+   static const unsigned char fillBytes [64] =
+    {
+      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+      255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+      255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255
+    };
+
+/*
+==============================================================================
+   Function: addSubSse2 (file scope only)
+------------------------------------------------------------------------------
+   OUTPUT: the carry out of the digits it did
+   NOTES:
+      basicAddSub on the last sixteen digits at a time, leaving n at the
+      digits still to do. Adding, a digit generates a carry when it sums
+      to more than nine, and passes one on when it sums to nine; borrows
+      are the same with less than zero and zero. A parallel prefix over
+      the sixteen digits (Kogge and Stone) works out which digits carry
+      out if no carry comes in (g) and which would pass on a carry that
+      did (p), so the carry in from the digits to the right only has to be
+      ORed in once.
+
+      A carry moves from digit i + 1 to digit i, which is toward the
+      front of the vector: _mm_srli_si128.
+==============================================================================
+*/
+   static char addSubSse2 (const char * left, const char * right, char * dest, int & n,
+      bool sub, char carry)
+    {
+      const __m128i zero = _mm_setzero_si128(), nine = _mm_set1_epi8(9),
+         ten = _mm_set1_epi8(10);
+      const __m128i fill1 = _mm_loadu_si128((const __m128i *) (fillBytes + 17)),
+         fill2 = _mm_loadu_si128((const __m128i *) (fillBytes + 18)),
+         fill4 = _mm_loadu_si128((const __m128i *) (fillBytes + 20)),
+         fill8 = _mm_loadu_si128((const __m128i *) (fillBytes + 24));
+
+      while (n >= 16)
+       {
+         n -= 16;
+         __m128i l = _mm_loadu_si128((const __m128i *) (left + n));
+         __m128i r = _mm_loadu_si128((const __m128i *) (right + n));
+         __m128i s, g, p;
+         if (sub)
+          {
+            s = _mm_sub_epi8(l, r);
+            g = _mm_cmplt_epi8(s, zero);
+            p = _mm_cmpeq_epi8(s, zero);
+          }
+         else
+          {
+            s = _mm_add_epi8(l, r);
+            g = _mm_cmpgt_epi8(s, nine);
+            p = _mm_cmpeq_epi8(s, nine);
+          }
+
+            //Past the end of the block, nothing generates and all passes
+         g = _mm_or_si128(g, _mm_and_si128(p, _mm_srli_si128(g, 1)));
+         p = _mm_and_si128(p, _mm_or_si128(_mm_srli_si128(p, 1), fill1));
+         g = _mm_or_si128(g, _mm_and_si128(p, _mm_srli_si128(g, 2)));
+         p = _mm_and_si128(p, _mm_or_si128(_mm_srli_si128(p, 2), fill2));
+         g = _mm_or_si128(g, _mm_and_si128(p, _mm_srli_si128(g, 4)));
+         p = _mm_and_si128(p, _mm_or_si128(_mm_srli_si128(p, 4), fill4));
+         g = _mm_or_si128(g, _mm_and_si128(p, _mm_srli_si128(g, 8)));
+         p = _mm_and_si128(p, _mm_or_si128(_mm_srli_si128(p, 8), fill8));
+
+            //Carries out, and carries in: the last digit takes carry
+         __m128i in = carry ? _mm_cmpeq_epi8(zero, zero) : zero;
+         __m128i out = _mm_or_si128(g, _mm_and_si128(p, in));
+         in = _mm_or_si128(_mm_srli_si128(out, 1), _mm_and_si128(in, fill1));
+
+            //in is -1 where there is a carry in
+         if (sub)
+          {
+            s = _mm_add_epi8(s, in);
+            s = _mm_add_epi8(s, _mm_and_si128(_mm_cmplt_epi8(s, zero), ten));
+          }
+         else
+          {
+            s = _mm_sub_epi8(s, in);
+            s = _mm_sub_epi8(s, _mm_and_si128(_mm_cmpgt_epi8(s, nine), ten));
+          }
+         _mm_storeu_si128((__m128i *) (dest + n), s);
+         carry = static_cast<char>(_mm_movemask_epi8(out) & 1);
+       }
+
+      return carry;
+    } //addSubSse2
+
+#ifdef COLUMN_AVX2
+   //Moves a vector d bytes toward its front, across the two lanes
+#define TOWARD_FRONT(x, d) \
+   _mm256_alignr_epi8(_mm256_permute2x128_si256((x), (x), 0x81), (x), (d))
+
+/*
+==============================================================================
+   Function: addSubAvx2 (file scope only)
+------------------------------------------------------------------------------
+   OUTPUT: the carry out of the digits it did
+   NOTES:
+      addSubSse2, thirty-two digits at a time.
+==============================================================================
+*/
+   __attribute__ ((target ("avx2")))
+   static char addSubAvx2 (const char * left, const char * right, char * dest, int & n,
+      bool sub, char carry)
+    {
+      const __m256i zero = _mm256_setzero_si256(), nine = _mm256_set1_epi8(9),
+         ten = _mm256_set1_epi8(10);
+      const __m256i fill1 = _mm256_loadu_si256((const __m256i *) (fillBytes + 1)),
+         fill2 = _mm256_loadu_si256((const __m256i *) (fillBytes + 2)),
+         fill4 = _mm256_loadu_si256((const __m256i *) (fillBytes + 4)),
+         fill8 = _mm256_loadu_si256((const __m256i *) (fillBytes + 8)),
+         fill16 = _mm256_loadu_si256((const __m256i *) (fillBytes + 16));
+
+      while (n >= 32)
+       {
+         n -= 32;
+         __m256i l = _mm256_loadu_si256((const __m256i *) (left + n));
+         __m256i r = _mm256_loadu_si256((const __m256i *) (right + n));
+         __m256i s, g, p;
+         if (sub)
+          {
+            s = _mm256_sub_epi8(l, r);
+            g = _mm256_cmpgt_epi8(zero, s);
+            p = _mm256_cmpeq_epi8(s, zero);
+          }
+         else
+          {
+            s = _mm256_add_epi8(l, r);
+            g = _mm256_cmpgt_epi8(s, nine);
+            p = _mm256_cmpeq_epi8(s, nine);
+          }
+
+         g = _mm256_or_si256(g, _mm256_and_si256(p, TOWARD_FRONT(g, 1)));
+         p = _mm256_and_si256(p, _mm256_or_si256(TOWARD_FRONT(p, 1), fill1));
+         g = _mm256_or_si256(g, _mm256_and_si256(p, TOWARD_FRONT(g, 2)));
+         p = _mm256_and_si256(p, _mm256_or_si256(TOWARD_FRONT(p, 2), fill2));
+         g = _mm256_or_si256(g, _mm256_and_si256(p, TOWARD_FRONT(g, 4)));
+         p = _mm256_and_si256(p, _mm256_or_si256(TOWARD_FRONT(p, 4), fill4));
+         g = _mm256_or_si256(g, _mm256_and_si256(p, TOWARD_FRONT(g, 8)));
+         p = _mm256_and_si256(p, _mm256_or_si256(TOWARD_FRONT(p, 8), fill8));
+         g = _mm256_or_si256(g, _mm256_and_si256(p, _mm256_permute2x128_si256(g, g, 0x81)));
+         p = _mm256_and_si256(p, _mm256_or_si256(_mm256_permute2x128_si256(p, p, 0x81), fill16));
+
+         __m256i in = carry ? _mm256_cmpeq_epi8(zero, zero) : zero;
+         __m256i out = _mm256_or_si256(g, _mm256_and_si256(p, in));
+         in = _mm256_or_si256(TOWARD_FRONT(out, 1), _mm256_and_si256(in, fill1));
+
+         if (sub)
+          {
+            s = _mm256_add_epi8(s, in);
+            s = _mm256_add_epi8(s, _mm256_and_si256(_mm256_cmpgt_epi8(zero, s), ten));
+          }
+         else
+          {
+            s = _mm256_sub_epi8(s, in);
+            s = _mm256_sub_epi8(s, _mm256_and_si256(_mm256_cmpgt_epi8(s, nine), ten));
+          }
+         _mm256_storeu_si256((__m256i *) (dest + n), s);
+         carry = static_cast<char>(_mm256_movemask_epi8(out) & 1);
+       }
+
+      return carry;
+    } //addSubAvx2
+
+#undef TOWARD_FRONT
+
+   static bool haveAvx2 (void)
+    {
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx2");
+    }
+#endif /* COLUMN_AVX2 */
+#endif /* COLUMN_SIMD */
+
 /*
 ==============================================================================
    Function: basicAddSub (file scope only)
@@ -565,12 +859,24 @@ namespace Col
       as division uses more subtractions than anything uses additions.
 
       THIS FUNCTION WILL !DOMINATE! CPU TIME
+
+      Where there are vector units, addSubSse2 and addSubAvx2 do all but
+      the first few digits.
 ==============================================================================
 */
    static void basicAddSub (const char * left, const char * right, char * dest, int n, bool sub)
     {
       char carry = 0;
 
+#ifdef COLUMN_SIMD
+         //The vectors do the back of the Column, the loops below the front
+#ifdef COLUMN_AVX2
+      static const bool avx2 = haveAvx2();
+      if (avx2) carry = addSubAvx2(left, right, dest, n, sub, carry);
+#endif /* COLUMN_AVX2 */
+      carry = addSubSse2(left, right, dest, n, sub, carry);
+#endif /* COLUMN_SIMD */
+
       if (sub) //subtracting
        {
          for (int i = n - 1; i >= 0; i--)
@@ -612,8 +918,8 @@ namespace Col
       Column & dest, int n)
     {
       int res;
-      char * temp1 = new char [n + 1];
-      char * temp2 = new char [n + 1];
+      char * temp1 = static_cast<char *>(grab(n + 1));
+      char * temp2 = static_cast<char *>(grab(n + 1));
 
       temp1[0] = 0;
       temp2[0] = 0;
@@ -646,7 +952,7 @@ namespace Col
          else
           {
             dest.Sign = false;
-            delete [] dest.Digits;
+            drop(dest.Digits, dest.Length);
             dest.Digits = NULL;
             dest.Zero = true;
           }
@@ -669,7 +975,7 @@ namespace Col
          else
           {
             dest.Sign = false;
-            delete [] dest.Digits;
+            drop(dest.Digits, dest.Length);
             dest.Digits = NULL;
             dest.Zero = true;
           }
@@ -683,8 +989,8 @@ namespace Col
          dest.Overflow = (temp1[0] != 0);
        }
 
-      delete [] temp1;
-      delete [] temp2;
+      drop(temp1, n + 1);
+      drop(temp2, n + 1);
     } //addSubHelper
 
 /*
@@ -700,7 +1006,7 @@ namespace Col
       if ((Length != right.Length) || right.Zero) return *this; //do nothing
       if (Zero)
        {
-         Digits = new char [right.Length];
+         Digits = static_cast<char *>(grab(right.Length));
          memcpy(Digits, right.Digits, right.Length);
          Sign = right.Sign;
          Zero = false;
@@ -723,7 +1029,7 @@ namespace Col
       if ((Length != right.Length) || right.Zero) return *this; //do nothing
       if (Zero)
        {
-         Digits = new char [right.Length];
+         Digits = static_cast<char *>(grab(right.Length));
          memcpy(Digits, right.Digits, right.Length);
          Sign = !right.Sign;
          Zero = false;
@@ -773,7 +1079,7 @@ namespace Col
       if (&right == this) return *this;
       if (right.Zero) //Then Digits is NULL and we don't need to allocate it.
        {
-         if (Digits) delete [] Digits;
+         if (Digits) drop(Digits, Length);
          Digits = NULL;
          Sign = right.Sign;
          Length = right.Length;
@@ -784,10 +1090,10 @@ namespace Col
        {
          if (Digits && (right.Length != Length))
           {
-            delete [] Digits;
-            Digits = new char [right.Length];
+            drop(Digits, Length);
+            Digits = static_cast<char *>(grab(right.Length));
           }
-         else if (!Digits) Digits = new char [right.Length];
+         else if (!Digits) Digits = static_cast<char *>(grab(right.Length));
          memcpy(Digits, right.Digits, right.Length);
          Sign = right.Sign;
          Length = right.Length;
@@ -821,14 +1127,14 @@ namespace Col
             if (i == Length) //We are now zero, too
              {
                Zero = true;
-               delete [] Digits;
+               drop(Digits, Length);
                Digits = NULL;
              }
           }
          else
           {
             Zero = true;
-            delete [] Digits;
+            drop(Digits, Length);
             Digits = NULL;
           }
        }
@@ -836,7 +1142,7 @@ namespace Col
        {
          if (Zero)
           {
-            Digits = new char [Length];
+            Digits = static_cast<char *>(grab(Length));
             Zero = false;
           }
          int useLength;
@@ -874,7 +1180,7 @@ namespace Col
          if (i == Length) //We are now zero, too
           {
             Zero = true;
-            delete [] Digits;
+            drop(Digits, Length);
             Digits = NULL;
           }
        }
@@ -882,7 +1188,7 @@ namespace Col
        {
          if (Zero)
           {
-            Digits = new char [Length];
+            Digits = static_cast<char *>(grab(Length));
             Zero = false;
           }
          memcpy(Digits + Length - right.Length, right.Digits, right.Length);
@@ -917,7 +1223,7 @@ namespace Col
          if (i == Length) //We are now zero, too
           {
             Zero = true;
-            delete [] Digits;
+            drop(Digits, Length);
             Digits = NULL;
           }
        }
@@ -925,7 +1231,7 @@ namespace Col
        {
          if (Zero)
           {
-            Digits = new char [Length];
+            Digits = static_cast<char *>(grab(Length));
             Zero = false;
           }
          Digits[0] = 0;
@@ -950,7 +1256,7 @@ namespace Col
     {
       if (Zero)
        {
-         Digits = new char [Length];
+         Digits = static_cast<char *>(grab(Length));
          memset(Digits, 0, Length - 1);
          Digits[Length - 1] = 1;
          Zero = false;
@@ -1003,7 +1309,7 @@ namespace Col
       if ((digit < 0) || (digit > Length)) return;
       if (Zero)
        {
-         Digits = new char [Length];
+         Digits = static_cast<char *>(grab(Length));
          memset(Digits, 0, Length - 1);
          Digits[digit] = 1;
          Zero = false;
@@ -1030,4 +1336,6 @@ namespace Col
        }
     } //incrementAt
 
+#endif /* ! COLUMN_PACKED */
+
  } //namespace Col
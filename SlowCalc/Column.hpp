@@ -25,7 +25,20 @@
 
 //HEADER:
 // string as we allow the construction of a column from a string
+// cstdint for the limbs of a packed Column
+// cstddef for size_t, for the digit array pool
 #include <string>
+#include <cstddef>
+#ifdef COLUMN_PACKED
+ #include <cstdint>
+#endif /* COLUMN_PACKED */
+
+/*
+   Define COLUMN_PACKED to store a Column as base 10^18 limbs, eighteen
+   digits to a uint64_t, instead of one digit to a char. The interface and
+   the decimal results are the same, except that digits() is not available.
+   PackedColumn.cpp holds that implementation.
+*/
 
 namespace Col
  {
@@ -35,7 +48,11 @@ namespace Col
    class Column
     {
       private:
+#ifdef COLUMN_PACKED
+         uint64_t * Limbs;
+#else
          char * Digits;
+#endif /* COLUMN_PACKED */
          bool Sign;
          int Length;
          bool Zero;
@@ -43,7 +60,21 @@ namespace Col
 
          static int minLength;
 
+            //Digit arrays come from a pool, kept by size
+         static void * grab (std::size_t);
+         static void drop (void *, std::size_t);
+
+#ifdef COLUMN_PACKED
+         int limbs (void) const;
+         int pad (void) const;
+         void allocate (void);
+         void release (void);
+         void checkZero (void);
+         void resize (int);
+         static void addSubHelper (bool, const uint64_t *, bool, const uint64_t *, Column &);
+#else
          static void addSubHelper (bool, char *, bool, char *, Column &, int);
+#endif /* COLUMN_PACKED */
 
       public:
          //All operators must occur with opperands of the same length, except all assignment
@@ -73,7 +104,12 @@ namespace Col
          bool operator == (const Column &);
          bool operator != (const Column &);
 
+#ifndef COLUMN_PACKED
          const char * digits (void) const;
+#else
+         //Sets this to the low length() digits of the product of the arguments
+         void product (const Column &, const Column &);
+#endif /* ! COLUMN_PACKED */
          int length (void) const;
          bool sign (void) const;
          bool isZero (void) const;
@@ -110,6 +146,10 @@ namespace Col
          static int getMinLength (void);
          static int setMinLength (int);
 
+            //Digit array pool reuses and trips to the heap, for the
+            //calculator to print
+         static void poolStatistics (unsigned long & hits, unsigned long & misses);
+
     }; // class Column
 
  } // namespace Col
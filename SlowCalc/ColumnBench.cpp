@@ -0,0 +1,92 @@
+/*
+   This file is part of SlowCalc.
+
+   Copyright (C) 2010 Thomas DiModica <ricinwich@yahoo.com>
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*
+   File: ColumnBench.cpp
+      Times Column += and -=, in nanoseconds per digit. ColumnBench.sh
+      builds this with each of the digit kernels.
+*/
+
+#include "Column.hpp"
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+using Col::Column;
+
+typedef std::chrono::steady_clock Clock;
+
+static const int Lengths [] = { 50, 200, 1000, 10000 };
+static const long Digits = 20000000; // Per length, so each takes as long
+
+static unsigned long long state = 88172645463325252ULL;
+
+static Column randomColumn (int length)
+ {
+   std::string digits;
+   for (int i = 0; i < length; i++)
+    {
+      state ^= state << 13;
+      state ^= state >> 7;
+      state ^= state << 17;
+      digits += static_cast<char>('0' + state % 10);
+    }
+   return Column(digits);
+ }
+
+int main (void)
+ {
+#if defined(COLUMN_SCALAR)
+   std::printf("Scalar digit loop\n");
+#elif defined(COLUMN_NO_AVX2)
+   std::printf("SSE2 kernel\n");
+#else
+   std::printf("Default kernels\n");
+#endif
+
+   long check = 0;
+   for (unsigned int k = 0; k < sizeof(Lengths) / sizeof(Lengths[0]); k++)
+    {
+      int length = Lengths[k];
+      long trials = Digits / length;
+      Column x = randomColumn(length), y = randomColumn(length);
+      x.setDigit(0, 1); // Neither overflows nor goes negative
+      y.setDigit(0, 0);
+
+      Clock::duration add (0), sub (0);
+      Clock::time_point start;
+      for (long i = 0; i < trials; i++)
+       {
+         start = Clock::now();
+         x += y;
+         add += Clock::now() - start;
+
+         start = Clock::now();
+         x -= y;
+         sub += Clock::now() - start;
+       }
+      check += x.digitAt(length - 1);
+
+      double scale = static_cast<double>(trials) * length;
+      std::printf("  %5d digits  += %6.3f  -= %6.3f ns/digit\n", length,
+         std::chrono::duration<double, std::nano>(add).count() / scale,
+         std::chrono::duration<double, std::nano>(sub).count() / scale);
+    }
+
+   return (check == -1) ? 1 : 0; // Keeps the work from being optimized away
+ }
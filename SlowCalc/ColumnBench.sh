@@ -0,0 +1,3 @@
+g++ -O2 -Wall -Wextra -Wpedantic -Wconversion -o ColumnBench ColumnBench.cpp Column.cpp
+g++ -O2 -Wall -Wextra -Wpedantic -Wconversion -DCOLUMN_NO_AVX2 -o ColumnBenchSse2 ColumnBench.cpp Column.cpp
+g++ -O2 -Wall -Wextra -Wpedantic -Wconversion -DCOLUMN_SCALAR -o ColumnBenchScalar ColumnBench.cpp Column.cpp
@@ -0,0 +1,106 @@
+/*
+   This file is part of SlowCalc.
+
+   Copyright (C) 2010 Thomas DiModica <ricinwich@yahoo.com>
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*
+   File: ColumnFuzz.cpp
+      Adds and subtracts random Columns and prints a checksum of the results
+      for every thousand. ColumnFuzz.sh builds this with each of the digit
+      kernels and compares what they print.
+
+      The digits are drawn to make long runs of nines and zeros, so that
+      carries and borrows cross the vectors.
+*/
+
+#include "Column.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+using Col::Column;
+
+static unsigned long long state = 88172645463325252ULL;
+
+static unsigned int random (unsigned int range)
+ {
+   state ^= state << 13;
+   state ^= state >> 7;
+   state ^= state << 17;
+   return static_cast<unsigned int>(state % range);
+ }
+
+static Column randomColumn (int length)
+ {
+   std::string digits;
+   if (random(2)) digits += '-';
+   int kind = static_cast<int>(random(4)), run = 0;
+   char last = '0';
+   for (int i = 0; i < length; i++)
+    {
+      if (run == 0)
+       {
+         run = static_cast<int>(random(40)) + 1;
+         if (kind == 0) last = '9';
+         else if (kind == 1) last = random(2) ? '9' : '0';
+         else last = static_cast<char>('0' + random(10));
+       }
+      run--;
+      if ((kind == 3) || (random(8) == 0)) digits += static_cast<char>('0' + random(10));
+      else digits += last;
+    }
+   return Column(digits);
+ }
+
+static unsigned long long hash = 14695981039346656037ULL;
+
+static void mix (unsigned long long value)
+ {
+   hash ^= value;
+   hash *= 1099511628211ULL;
+ }
+
+static void mix (const Column & result)
+ {
+   mix(result.sign());
+   mix(result.isZero());
+   mix(result.overflow());
+   for (int i = 0; i < result.length(); i++)
+      mix(static_cast<unsigned long long>(result.digitAt(i)));
+ }
+
+int main (int argc, char ** argv)
+ {
+   int cases = (argc > 1) ? std::atoi(argv[1]) : 200000;
+
+   Column::setMinLength(1);
+   for (int i = 1; i <= cases; i++)
+    {
+      int length = static_cast<int>(random(random(4) ? 100 : 1000)) + 1;
+      Column left = randomColumn(length), right = randomColumn(length);
+      switch (random(4))
+       {
+         case 0: left += right; break;
+         case 1: left -= right; break;
+         case 2: left += left; break;
+         default: left = left + right - right; break;
+       }
+      mix(left);
+      if ((i % 1000) == 0) std::printf("%d %016llx\n", i, hash);
+    }
+
+   return 0;
+ }
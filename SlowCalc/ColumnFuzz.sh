@@ -0,0 +1,7 @@
+g++ -O2 -Wall -Wextra -Wpedantic -Wconversion -o ColumnFuzz ColumnFuzz.cpp Column.cpp
+g++ -O2 -Wall -Wextra -Wpedantic -Wconversion -DCOLUMN_NO_AVX2 -o ColumnFuzzSse2 ColumnFuzz.cpp Column.cpp
+g++ -O2 -Wall -Wextra -Wpedantic -Wconversion -DCOLUMN_SCALAR -o ColumnFuzzScalar ColumnFuzz.cpp Column.cpp
+./ColumnFuzz > ColumnFuzz.out
+./ColumnFuzzSse2 > ColumnFuzzSse2.out
+./ColumnFuzzScalar > ColumnFuzzScalar.out
+cmp ColumnFuzzScalar.out ColumnFuzzSse2.out && cmp ColumnFuzzScalar.out ColumnFuzz.out && echo "All kernels agree"
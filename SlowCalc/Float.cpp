@@ -27,9 +27,13 @@
 
 //HEADER:
 // sstream and iomanip allow us to do easy conversion to/from macine numbers
+// vector, algorithm and cstdint for the limbs that division works in
 // Float defines the class that these functions operate on.
 #include <sstream>
 #include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
 #include "Float.hpp"
 
 /* The fancy logic for the two other modes of calculators. */
@@ -201,10 +205,8 @@ namespace DecFloat
        }
       else //return a string of ASCII digits
        {
-         //gcc doesn't like me defining two loop variables of different types.
-         const char * p = Significand.digits();
          for (int i = 0; i < Significand.length(); i++)
-            result += static_cast<char>(p[i] + '0');
+            result += static_cast<char>(Significand.digitAt(i) + '0');
        }
       return result;
     }
@@ -1068,6 +1070,7 @@ namespace DecFloat
 */
    Float operator * (const Float & left, const Float & right)
     {
+#ifndef COLUMN_PACKED
       /*
          So: x * y, if x and y are one digit numbers, = wz
             multtens is the w
@@ -1105,6 +1108,7 @@ namespace DecFloat
          { 0, 0, 1, 2, 3, 4, 4, 5, 6, 7},
          { 0, 0, 1, 2, 3, 4, 5, 6, 7, 8}
        };
+#endif /* ! COLUMN_PACKED */
 
       Float Temp1 (left), Temp2 (right);
       Temp1 || Temp2;
@@ -1134,6 +1138,12 @@ namespace DecFloat
          return Temp1;
        }
 
+#ifdef COLUMN_PACKED
+         //The limbs multiply out the whole double-length product at once
+      Column z;
+      z.setLength(Temp1.length() * 2);
+      z.product(Temp1.Significand, Temp2.Significand);
+#else
          //Prepare for multiply: this is the basic shift-accumulate algorithm
          //It operates in the same manner as a fixed-point calculation
       Column x, y, z, a, b;
@@ -1171,6 +1181,7 @@ namespace DecFloat
             //The outer loop "shifts" y, reducing the need to move data
          x <<= 1;
        }
+#endif /* COLUMN_PACKED */
 
          //Calculate exponent
       Temp3.Exponent = Temp1.Exponent + Temp2.Exponent;
@@ -1213,62 +1224,330 @@ namespace DecFloat
       return Temp3;
     }
 
+/*
+   Division does its arithmetic on base one billion limbs, least
+   significant limb first, with no zero limbs on the top: zero has none.
+   The limbs are only a scratch form. Whatever the Column underneath,
+   division reads the digits out and writes the same quotient digits
+   that the shift-subtract loop would have. Significands are no longer
+   than maxLength digits, so schoolbook long division is all it needs.
+*/
+   typedef std::vector<uint32_t> Limbs;
+
+   static const uint32_t limbBase = 1000000000;
+   static const uint32_t limbPowers [9] =
+      { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000 };
+
 /*
 ==============================================================================
-   Function: divide operator
+   Function: trimLimbs (file scope only)
+==============================================================================
+*/
+   static void trimLimbs (Limbs & a)
+    {
+      while (!a.empty() && (a.back() == 0)) a.pop_back();
+    }
+
+/*
+==============================================================================
+   Function: compareLimbs (file scope only)
+------------------------------------------------------------------------------
+   OUTPUT:
+      <0  if left <  right
+      0   if left == right
+      >0  if left >  right
+==============================================================================
+*/
+   static int compareLimbs (const Limbs & left, const Limbs & right)
+    {
+      if (left.size() != right.size()) return (left.size() < right.size()) ? -1 : 1;
+      for (std::size_t i = left.size(); i > 0; i--)
+         if (left[i - 1] != right[i - 1]) return (left[i - 1] < right[i - 1]) ? -1 : 1;
+      return 0;
+    }
+
+/*
+==============================================================================
+   Function: addLimbs (file scope only)
 ------------------------------------------------------------------------------
    NOTES:
-      Considering the stink that gradual underflow raised in the IEEE-754
-      standardization process, it is humorous that it is not implemented
-      here.
-      Subnormals are not handled for the same reason that DEC didn't want
-      to handle them: it slows down computation.
+      left += right
 ==============================================================================
 */
-   Float operator / (const Float & left, const Float & right)
+   static void addLimbs (Limbs & left, const Limbs & right)
     {
-      Float Temp1 (left), Temp2 (right);
-      Temp1 || Temp2;
-      Float Temp3(Temp1);
+      if (right.empty()) return;
+      if (left.size() < right.size()) left.resize(right.size(), 0);
+      uint32_t carry = 0;
+      std::size_t i;
+      for (i = 0; i < right.size(); i++)
+       {
+         uint32_t sum = left[i] + right[i] + carry;
+         carry = (sum >= limbBase) ? 1 : 0;
+         left[i] = sum - carry * limbBase;
+       }
+      for (; (carry != 0) && (i < left.size()); i++)
+       {
+         if (++left[i] == limbBase) left[i] = 0;
+         else carry = 0;
+       }
+      if (carry != 0) left.push_back(1);
+    }
 
-         //Finally, NaN has precedence
-      if (left.isNaN() || right.isNaN()) return (Temp1 |= fNaN);
+/*
+==============================================================================
+   Function: subtractLimbs (file scope only)
+------------------------------------------------------------------------------
+   NOTES:
+      left -= right, which must not be more than left.
+==============================================================================
+*/
+   static void subtractLimbs (Limbs & left, const Limbs & right)
+    {
+      uint32_t borrow = 0;
+      std::size_t i;
+      for (i = 0; i < right.size(); i++)
+       {
+         uint32_t take = right[i] + borrow;
+         borrow = (left[i] < take) ? 1 : 0;
+         left[i] = left[i] + borrow * limbBase - take;
+       }
+      for (; (borrow != 0) && (i < left.size()); i++)
+       {
+         if (left[i] == 0) left[i] = limbBase - 1;
+         else
+          {
+            left[i]--;
+            borrow = 0;
+          }
+       }
+      trimLimbs(left);
+    }
 
-         //Handle the two Inf/Inf and 0/0 NaN cases
-      if ((left.isZero() && right.isZero()) ||
-          (left.isInfinity() && right.isInfinity())) return (Temp1 |= fNaN);
+/*
+==============================================================================
+   Function: shortMultiply (file scope only)
+------------------------------------------------------------------------------
+   NOTES:
+      a = a * by + add, for by and add less than the base.
+==============================================================================
+*/
+   static void shortMultiply (Limbs & a, uint32_t by, uint32_t add = 0)
+    {
+      uint64_t carry = add;
+      for (std::size_t i = 0; i < a.size(); i++)
+       {
+         uint64_t part = static_cast<uint64_t>(a[i]) * by + carry;
+         a[i] = static_cast<uint32_t>(part % limbBase);
+         carry = part / limbBase;
+       }
+      if (carry != 0) a.push_back(static_cast<uint32_t>(carry));
+      trimLimbs(a);
+    }
 
-         //Return an infinity
-      if (left.isInfinity() || right.isZero())
+/*
+==============================================================================
+   Function: shortDivide (file scope only)
+------------------------------------------------------------------------------
+   OUTPUT: the remainder
+   NOTES:
+      a = a / by, for by less than the base.
+==============================================================================
+*/
+   static uint32_t shortDivide (Limbs & a, uint32_t by)
+    {
+      uint64_t rem = 0;
+      for (std::size_t i = a.size(); i > 0; i--)
        {
-         Temp1 |= fInf;
-         if (left.sign() != right.sign()) Temp1.Significand.negate();
-         return Temp1;
+         uint64_t part = rem * limbBase + a[i - 1];
+         a[i - 1] = static_cast<uint32_t>(part / by);
+         rem = part % by;
        }
+      trimLimbs(a);
+      return static_cast<uint32_t>(rem);
+    }
 
-         //Return a zero
-      if (left.isZero() || right.isInfinity())
+/*
+==============================================================================
+   Function: schoolDivide (file scope only)
+------------------------------------------------------------------------------
+   NOTES:
+      Long division: quot = num / den, rem = num % den.
+
+      Both are first scaled so that the top limb of den is at least half the
+      base. Then each quotient limb is estimated from the top two limbs of
+      what is left and the top limb of den, that estimate is checked against
+      the second limb of den, and the at most one too large estimate that
+      gets through is corrected by adding den back once.
+==============================================================================
+*/
+   static void schoolDivide (const Limbs & num, const Limbs & den, Limbs & quot, Limbs & rem)
+    {
+      if (compareLimbs(num, den) < 0)
        {
-         Temp1.Exponent = 0;
-         Temp1.Significand.setToZero();
-         Temp1.Significand.absoluteValue();
-         if (left.sign() != right.sign()) Temp1.Significand.negate();
-         return Temp1;
+         quot.clear();
+         rem = num;
+         return;
+       }
+      if (den.size() == 1)
+       {
+         quot = num;
+         rem.assign(1, shortDivide(quot, den[0]));
+         trimLimbs(rem);
+         return;
        }
 
+      uint32_t scale = limbBase / (den.back() + 1);
+      Limbs u (num), v (den);
+      shortMultiply(u, scale);
+      shortMultiply(v, scale);
+      std::size_t n = v.size(), m = u.size() - n;
+      u.push_back(0);
+      quot.assign(m + 1, 0);
+
+      const uint64_t top = v[n - 1], next = v[n - 2];
+      for (std::size_t j = m + 1; j > 0; j--)
+       {
+         std::size_t at = j - 1;
+         uint64_t head = static_cast<uint64_t>(u[at + n]) * limbBase + u[at + n - 1];
+         uint64_t qhat = head / top, rhat = head % top;
+         while ((qhat >= limbBase) || (qhat * next > rhat * limbBase + u[at + n - 2]))
+          {
+            qhat--;
+            rhat += top;
+            if (rhat >= limbBase) break;
+          }
+
+         uint64_t carry = 0;
+         int64_t borrow = 0;
+         for (std::size_t i = 0; i < n; i++)
+          {
+            uint64_t part = qhat * v[i] + carry;
+            carry = part / limbBase;
+            int64_t diff = static_cast<int64_t>(u[at + i]) - static_cast<int64_t>(part % limbBase) - borrow;
+            borrow = (diff < 0) ? 1 : 0;
+            u[at + i] = static_cast<uint32_t>(diff + borrow * limbBase);
+          }
+         int64_t diff = static_cast<int64_t>(u[at + n]) - static_cast<int64_t>(carry) - borrow;
+
+         if (diff < 0) //Estimate was one too large: add back
+          {
+            qhat--;
+            uint32_t back = 0;
+            for (std::size_t i = 0; i < n; i++)
+             {
+               uint32_t sum = u[at + i] + v[i] + back;
+               back = (sum >= limbBase) ? 1 : 0;
+               u[at + i] = sum - back * limbBase;
+             }
+            diff += back; //The carry out cancels the borrow
+          }
+         u[at + n] = static_cast<uint32_t>(diff);
+         quot[at] = static_cast<uint32_t>(qhat);
+       }
+
+      trimLimbs(quot);
+      u.resize(n);
+      trimLimbs(u);
+      shortDivide(u, scale);
+      rem = u;
+    }
+
+/*
+==============================================================================
+   Function: readLimbs (file scope only)
+------------------------------------------------------------------------------
+   OUTPUT: the digits of from, starting at from and up to but not including
+      upTo, as an integer, times ten to the shift.
+==============================================================================
+*/
+   static Limbs readLimbs (const Column & from, int upTo, int shift)
+    {
+      Limbs res (static_cast<std::size_t>((upTo + shift + 8) / 9), 0);
+      for (int i = 0; i < upTo; i++)
+       {
+         int power = upTo - 1 - i + shift;
+         res[static_cast<std::size_t>(power / 9)] +=
+            static_cast<uint32_t>(from.digitAt(i)) * limbPowers[power % 9];
+       }
+      trimLimbs(res);
+      return res;
+    }
+
+/*
+==============================================================================
+   Function: estimateDivide (file scope only)
+------------------------------------------------------------------------------
+   NOTES:
+      Sets z to what shiftSubtractDivide sets it to, for normalized
+      significands of at least two digits, but a limb at a time.
+
+      For n digit significands X and Y, shiftSubtractDivide's quotient is
+      exact down to the digit where the divisor lines up with Y itself,
+      which is X 10^(n+1) / Y. There, Column subtraction leaves out the last
+      digit of each side, so the remainder R goes down by Y / 10 for each
+      subtraction, and it keeps subtracting while R > Y / 10 (or R >= Y / 10,
+      when Y ends in zero). z is the quotient with that last digit, then a
+      zero.
+==============================================================================
+*/
+   static void estimateDivide (const Column & dividend, const Column & divisor, Column & z)
+    {
+      int n = dividend.length();
+      Limbs num (readLimbs(dividend, n, n + 1)), den (readLimbs(divisor, n, 0));
+      Limbs quot, rem;
+
+      schoolDivide(num, den, quot, rem);
+
+         //The last quotient digit
+      Limbs tenth (readLimbs(divisor, n - 1, 0));
+      Limbs stop (tenth);
+      uint32_t last = 0;
+      if (divisor.digitAt(n - 1) != 0) addLimbs(stop, Limbs(1, 1));
+      while (compareLimbs(rem, stop) >= 0)
+       {
+         subtractLimbs(rem, tenth);
+         last++;
+       }
+      shortMultiply(quot, 10, last);
+
+         //Write it out, and leave the final digit zero
+      int digit = z.length() - 2;
+      for (std::size_t i = 0; i < quot.size(); i++)
+       {
+         uint32_t limb = quot[i];
+         for (int j = 0; (j < 9) && (digit >= 0); j++, digit--)
+          {
+            z.setDigit(digit, static_cast<int>(limb % 10));
+            limb /= 10;
+          }
+       }
+    }
+
+/*
+==============================================================================
+   Function: shiftSubtractDivide (file scope only)
+------------------------------------------------------------------------------
+   NOTES:
+      The original divide: sets z to the quotient of the two significands,
+      one digit position at a time, by as many subtractions as fit.
+==============================================================================
+*/
+   static void shiftSubtractDivide (const Column & dividend, const Column & divisor, Column & z)
+    {
          //Prepare for divide: this is the basic shift-decrement algorithm
          //It uses the same strategy as a fixed-point divide would use
          //Except it calculates two extra digits to ensure correct rounding
-      Column x, y, z, a;
+      Column x, y, a;
 
-      x.setLength(Temp1.length() * 2 + 3); // +2 to add one extra digit
-      y.setLength(Temp1.length() * 2 + 3); // in worst case divides
-      z.setLength(Temp1.length() * 2 + 3); // +1 to add a zero pad
-      a.setLength(Temp1.length() * 2 + 3); // to improve compares
+      x.setLength(dividend.length() * 2 + 3); // +2 to add one extra digit
+      y.setLength(dividend.length() * 2 + 3); // in worst case divides
+      a.setLength(dividend.length() * 2 + 3); // +1 to add a zero pad
+                                              // to improve compares
 
-      x *= Temp1.Significand; //Dividend
-      y &= Temp2.Significand; //Our limiting condition
-      a *= Temp2.Significand; //Multiplied divisor
+      x *= dividend; //Dividend
+      y &= divisor; //Our limiting condition
+      a *= divisor; //Multiplied divisor
 
       x.absoluteValue(); //Oh God!
       y.absoluteValue(); //I forgot about this!
@@ -1320,6 +1599,59 @@ namespace DecFloat
           }
        }
       //The divide is over!
+    }
+
+/*
+==============================================================================
+   Function: divide operator
+------------------------------------------------------------------------------
+   NOTES:
+      Considering the stink that gradual underflow raised in the IEEE-754
+      standardization process, it is humorous that it is not implemented
+      here.
+      Subnormals are not handled for the same reason that DEC didn't want
+      to handle them: it slows down computation.
+==============================================================================
+*/
+   Float operator / (const Float & left, const Float & right)
+    {
+      Float Temp1 (left), Temp2 (right);
+      Temp1 || Temp2;
+      Float Temp3(Temp1);
+
+         //Finally, NaN has precedence
+      if (left.isNaN() || right.isNaN()) return (Temp1 |= fNaN);
+
+         //Handle the two Inf/Inf and 0/0 NaN cases
+      if ((left.isZero() && right.isZero()) ||
+          (left.isInfinity() && right.isInfinity())) return (Temp1 |= fNaN);
+
+         //Return an infinity
+      if (left.isInfinity() || right.isZero())
+       {
+         Temp1 |= fInf;
+         if (left.sign() != right.sign()) Temp1.Significand.negate();
+         return Temp1;
+       }
+
+         //Return a zero
+      if (left.isZero() || right.isInfinity())
+       {
+         Temp1.Exponent = 0;
+         Temp1.Significand.setToZero();
+         Temp1.Significand.absoluteValue();
+         if (left.sign() != right.sign()) Temp1.Significand.negate();
+         return Temp1;
+       }
+
+         //Two digits past twice the length, for rounding, and a zero pad
+      Column z;
+      z.setLength(Temp1.length() * 2 + 3);
+
+      if ((Temp1.length() > 1) && (Temp1.Significand.digitAt(0) != 0) &&
+         (Temp2.Significand.digitAt(0) != 0))
+         estimateDivide(Temp1.Significand, Temp2.Significand, z);
+      else shiftSubtractDivide(Temp1.Significand, Temp2.Significand, z);
 
          //Calculate exponent
       Temp3.Exponent = Temp1.Exponent - Temp2.Exponent;
@@ -0,0 +1,1017 @@
+/*
+   This file is part of SlowCalc.
+
+   Copyright (C) 2010 Thomas DiModica <ricinwich@yahoo.com>
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*
+   File: PackedColumn.cpp
+      The same column of digit wheels as Column.cpp, but the wheels are
+      ganged eighteen to a uint64_t limb. Add, subtract and compare move
+      eighteen digits at a time, and multiply works a limb at a time.
+
+      Limbs[0] is the most significant limb. The digits are right-justified
+      in the limbs, so the first limb carries pad() leading zero digits and
+      the limbs, read together, are the Column as a base 10^18 integer.
+      Digit index 0 is still the most significant digit.
+
+      Only compiled in when COLUMN_PACKED is defined.
+*/
+
+//HEADER:
+// Column, as we need the definition of a Column
+//   and Column includes <string> and <cstdint>
+// cstring for the memory manipulation functions contained there in
+#include "Column.hpp"
+
+#ifdef COLUMN_PACKED
+
+#include <cstring>
+
+#ifndef __SIZEOF_INT128__
+ #error "COLUMN_PACKED needs a compiler with unsigned __int128"
+#endif
+
+using std::memcpy;
+using std::memset;
+
+namespace Col
+ {
+
+   __extension__ typedef unsigned __int128 Wide;
+
+   static const uint64_t Base = 1000000000000000000ULL;
+
+   static const uint64_t tenTo [19] =
+    {
+      1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+      10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL,
+      100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+      100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+      100000000000000000ULL, 1000000000000000000ULL
+    };
+
+/*
+==============================================================================
+   Function: shiftDownPart (file scope only)
+------------------------------------------------------------------------------
+   NOTES:
+      Divides an n limb number by 10^(18 * whole + Part) in place, discarding
+      the remainder. Part is a template argument so that the divides by a
+      power of ten compile to multiplies.
+==============================================================================
+*/
+   template <int Part>
+   static void shiftDownPart (uint64_t * limbs, int n, int whole)
+    {
+      const uint64_t low = tenTo[Part], high = tenTo[18 - Part];
+      for (int i = n - 1; i >= 0; i--)
+       {
+         int src = i - whole;
+         uint64_t value = 0;
+         if (src >= 0) value = limbs[src] / low;
+         if (src >= 1) value += (limbs[src - 1] % low) * high;
+         limbs[i] = value;
+       }
+    }
+
+/*
+==============================================================================
+   Function: shiftUpPart (file scope only)
+------------------------------------------------------------------------------
+   NOTES:
+      Multiplies an n limb number by 10^(18 * whole + Part) in place,
+      discarding what runs off the top limb. The caller masks the top limb
+      to its length.
+==============================================================================
+*/
+   template <int Part>
+   static void shiftUpPart (uint64_t * limbs, int n, int whole)
+    {
+      const uint64_t low = tenTo[Part], high = tenTo[18 - Part];
+      for (int i = 0; i < n; i++)
+       {
+         int src = i + whole;
+         uint64_t value = 0;
+         if (src < n) value = (limbs[src] % high) * low;
+         if (src + 1 < n) value += limbs[src + 1] / high;
+         limbs[i] = value;
+       }
+    }
+
+   typedef void (* Shifter) (uint64_t *, int, int);
+
+#define COLUMN_PARTS(shift) \
+    { \
+      &shift<0>, &shift<1>, &shift<2>, &shift<3>, &shift<4>, &shift<5>, \
+      &shift<6>, &shift<7>, &shift<8>, &shift<9>, &shift<10>, &shift<11>, \
+      &shift<12>, &shift<13>, &shift<14>, &shift<15>, &shift<16>, &shift<17> \
+    }
+
+   static const Shifter shiftDowns [18] = COLUMN_PARTS(shiftDownPart);
+   static const Shifter shiftUps [18] = COLUMN_PARTS(shiftUpPart);
+
+#undef COLUMN_PARTS
+
+/*
+==============================================================================
+   Function group: shiftDown and shiftUp (file scope only)
+------------------------------------------------------------------------------
+   NOTES:
+      Scale an n limb number by 10^places.
+==============================================================================
+*/
+   static void shiftDown (uint64_t * limbs, int n, int places)
+    { shiftDowns[places % 18](limbs, n, places / 18); }
+   static void shiftUp (uint64_t * limbs, int n, int places)
+    { shiftUps[places % 18](limbs, n, places / 18); }
+
+/*
+==============================================================================
+   Function: place (file scope only)
+------------------------------------------------------------------------------
+   NOTES:
+      Copies a number between limb arrays of different sizes, keeping the
+      low limbs. It will not fit if dest is shorter than the nonzero part
+      of src.
+==============================================================================
+*/
+   static void place (const uint64_t * src, int srcN, uint64_t * dest, int destN)
+    {
+      if (destN >= srcN)
+       {
+         memset(dest, 0, (destN - srcN) * sizeof(uint64_t));
+         memcpy(dest + destN - srcN, src, srcN * sizeof(uint64_t));
+       }
+      else memcpy(dest, src + srcN - destN, destN * sizeof(uint64_t));
+    }
+
+/*
+==============================================================================
+   Function: clearDigits (file scope only)
+------------------------------------------------------------------------------
+   NOTES:
+      Zeros the digits from up to but not including to, where the first
+      limb carries pad leading zeros.
+==============================================================================
+*/
+   static void clearDigits (uint64_t * limbs, int pad, int from, int to)
+    {
+      from += pad;
+      to += pad;
+      for (int i = from / 18; (i * 18) < to; i++)
+       {
+         int start = (from > (i * 18)) ? (from - i * 18) : 0;
+         int stop = (to < (i * 18 + 18)) ? (to - i * 18) : 18;
+            //Keep the digits above start and below stop
+         limbs[i] = limbs[i] / tenTo[18 - start] * tenTo[18 - start] +
+                    limbs[i] % tenTo[18 - stop];
+       }
+    }
+
+/*
+==============================================================================
+   Function: basicCompare (file scope only)
+------------------------------------------------------------------------------
+   OUTPUT:
+      <0  if left <  right
+      0   if left == right
+      >0  if left >  right
+   NOTES:
+      Compares the digits from start onward.
+==============================================================================
+*/
+   static int basicCompare (const uint64_t * left, const uint64_t * right, int n,
+      int pad, int start)
+    {
+      int first = (start + pad) / 18;
+      if (first >= n) return 0;
+      uint64_t mask = tenTo[18 - (start + pad) % 18];
+      uint64_t l = left[first] % mask, r = right[first] % mask;
+      if (l != r) return (l < r) ? -1 : 1;
+      for (int i = first + 1; i < n; i++)
+         if (left[i] != right[i]) return (left[i] < right[i]) ? -1 : 1;
+      return 0;
+    }
+
+/*
+==============================================================================
+   Function group: limb layout
+==============================================================================
+*/
+   int Column::limbs (void) const { return (Length + 17) / 18; }
+   int Column::pad (void) const { return limbs() * 18 - Length; }
+
+/*
+==============================================================================
+   Function: allocate
+------------------------------------------------------------------------------
+   NOTES:
+      Gives a zero Column zeroed limbs, so that digits can be set.
+==============================================================================
+*/
+   void Column::allocate (void)
+    {
+      Limbs = static_cast<uint64_t *>(grab(limbs() * sizeof(uint64_t)));
+      memset(Limbs, 0, limbs() * sizeof(uint64_t));
+      Zero = false;
+    }
+
+/*
+==============================================================================
+   Function: release
+==============================================================================
+*/
+   void Column::release (void)
+    {
+      if (Limbs != NULL) drop(Limbs, limbs() * sizeof(uint64_t));
+      Limbs = NULL;
+      Zero = true;
+    }
+
+/*
+==============================================================================
+   Function: checkZero
+==============================================================================
+*/
+   void Column::checkZero (void)
+    {
+      if (Zero) return;
+      int n = limbs();
+      for (int i = 0; i < n; i++) if (Limbs[i]) return;
+      release();
+    }
+
+/*
+==============================================================================
+   Function: resize
+------------------------------------------------------------------------------
+   NOTES:
+      Grows or shrinks a nonzero Column on the right.
+      Like the unpacked Column, shrinking never makes the Column zero.
+==============================================================================
+*/
+   void Column::resize (int newLength)
+    {
+      int oldLimbs = limbs();
+      if (newLength < Length) shiftDown(Limbs, oldLimbs, Length - newLength);
+      int delta = newLength - Length;
+      Length = newLength;
+      if (limbs() != oldLimbs)
+       {
+         uint64_t * newLimbs = static_cast<uint64_t *>(grab(limbs() * sizeof(uint64_t)));
+         place(Limbs, oldLimbs, newLimbs, limbs());
+         drop(Limbs, oldLimbs * sizeof(uint64_t));
+         Limbs = newLimbs;
+       }
+      if (delta > 0) shiftUp(Limbs, limbs(), delta);
+    }
+
+/*
+==============================================================================
+   Function: no argument Column constructor
+==============================================================================
+*/
+   Column::Column () :
+      Limbs(NULL), Sign(false), Length(minLength), Zero(true), Overflow(false)
+    {
+
+    }
+
+/*
+==============================================================================
+   Function: Column destructor
+==============================================================================
+*/
+   Column::~Column ()
+    {
+      if (Limbs != NULL) drop(Limbs, limbs() * sizeof(uint64_t));
+      Limbs = NULL;
+    }
+
+/*
+==============================================================================
+   Function: copy constructor
+==============================================================================
+*/
+   Column::Column (const Column & src) :
+      Limbs(NULL), Sign(src.Sign), Length(src.Length), Zero(src.Zero),
+      Overflow(src.Overflow)
+    {
+      if (!src.Zero)
+       {
+         Limbs = static_cast<uint64_t *>(grab(limbs() * sizeof(uint64_t)));
+         memcpy(Limbs, src.Limbs, limbs() * sizeof(uint64_t));
+       }
+    } //Column (const Column &)
+
+/*
+==============================================================================
+   Function: constructor from a string
+==============================================================================
+*/
+   Column::Column (const std::string & srcString) :
+      Limbs(NULL), Sign(false), Length(minLength), Zero(true), Overflow(false)
+    {
+      const char * p = srcString.c_str();
+      if (srcString.length() == 0) return;
+      if (*p == '-')
+       {
+         Sign = true;
+         p++;
+       }
+      int tempLength = 0;
+      while ((p[tempLength] >= '0') && (p[tempLength] <= '9')) tempLength++;
+      if (tempLength > minLength) Length = tempLength;
+      allocate();
+         //The digits are left-justified: digit i goes to place pad() + i
+      int at = pad();
+      for (int i = 0; i < tempLength; i++, at++)
+         Limbs[at / 18] += static_cast<uint64_t>(p[i] - '0') * tenTo[17 - at % 18];
+      checkZero();
+    } //Column (string)
+
+/*
+==============================================================================
+   Function group: member variable access functions
+==============================================================================
+*/
+   int Column::length (void) const { return Length; }
+   bool Column::sign (void) const { return Sign; }
+   bool Column::isZero (void) const { return Zero; }
+   bool Column::overflow (void) const { return Overflow; }
+
+/*
+==============================================================================
+   Function group: member variable manipulation functions
+==============================================================================
+*/
+   void Column::negate (void) { Sign = !Sign; }
+   void Column::absoluteValue (void) { Sign = false; }
+   void Column::clearOverflow (void) { Overflow = false; }
+
+/*
+==============================================================================
+   Function: setToZero
+==============================================================================
+*/
+   void Column::setToZero (void) { release(); }
+
+/*
+==============================================================================
+   Function: setToZero range
+------------------------------------------------------------------------------
+   NOTES:
+      Works on a range rather than setting the whole Column.
+==============================================================================
+*/
+   void Column::setToZero (int from, int to)
+    {
+      if (Zero) return;
+      if (from < 0) from = 0;
+      else if (from > Length) from = Length;
+      if (to > Length) to = Length;
+      if ((from == 0) && (to == Length))
+       {
+         release();
+         return;
+       }
+      if (from < to) clearDigits(Limbs, pad(), from, to);
+      checkZero();
+    } //setToZero (int, int)
+
+/*
+==============================================================================
+   Function: lengthen by an amount
+==============================================================================
+*/
+   int Column::lengthen (int delta)
+    {
+      if (Zero) Length += delta;
+      else resize(Length + delta);
+      return Length;
+    } //lengthen
+
+/*
+==============================================================================
+   Function: truncate (shorten by an amount)
+==============================================================================
+*/
+   int Column::truncate (int delta)
+    {
+      int newLength = Length - delta;
+      if (newLength < minLength) newLength = minLength;
+      if (Zero) Length = newLength;
+      else if (newLength != Length) resize(newLength);
+      return Length;
+    } //truncate
+
+/*
+==============================================================================
+   Function: setLength
+==============================================================================
+*/
+   int Column::setLength (int absolute)
+    {
+      if (absolute < minLength) absolute = minLength;
+      if (Zero) Length = absolute;
+      else if (absolute != Length) resize(absolute);
+      return Length;
+    } //setLength
+
+/*
+==============================================================================
+   Function: compare
+------------------------------------------------------------------------------
+   OUTPUT:
+      <0  if left <  right
+      0   if left == right
+      >0  if left >  right
+   NOTES:
+      Returns 0 if the two columns are of different lengths.
+      It does not even try a comparison.
+==============================================================================
+*/
+   int Column::compare (const Column & right)
+    {
+      return compare(right, 0);
+    }
+
+/*
+==============================================================================
+   Function: compare
+------------------------------------------------------------------------------
+   OUTPUT:
+      <0  if left <  right
+      0   if left == right
+      >0  if left >  right
+   NOTES:
+      Allows specification of a starting index to do the compare.
+      Only the limbs from the one holding start onward are compared.
+
+      Returns 0 if the two columns are of different lengths.
+      It does not even try a comparison.
+==============================================================================
+*/
+   int Column::compare (const Column & right, int start)
+    {
+      if (Length != right.Length) return 0;
+      if (Zero && right.Zero) return 0;
+
+      if (Sign && right.Sign)
+       {
+         if (Zero && !right.Zero) return 1;
+         else if (!Zero && right.Zero) return -1;
+         return -basicCompare(Limbs, right.Limbs, limbs(), pad(), start);
+       }
+      else if (!Sign && right.Sign) return -1;
+      else if (Sign && !right.Sign) return 1;
+
+      if (Zero && !right.Zero) return -1;
+      else if (!Zero && right.Zero) return 1;
+      return basicCompare(Limbs, right.Limbs, limbs(), pad(), start);
+    }
+
+/*
+==============================================================================
+   Function group: equivalence and relational operators
+------------------------------------------------------------------------------
+   NOTES:
+      Returns 0 if the two columns are of different lengths.
+      It does not even try a comparison.
+==============================================================================
+*/
+   bool Column::operator == (const Column & right) { return (compare(right) == 0); }
+   bool Column::operator != (const Column & right) { return (compare(right) != 0); }
+   bool Column::operator > (const Column & right) { return (compare(right) > 0); }
+   bool Column::operator >= (const Column & right) { return (compare(right) >= 0); }
+   bool Column::operator < (const Column & right) { return (compare(right) < 0); }
+   bool Column::operator <= (const Column & right) { return (compare(right) <= 0); }
+
+/*
+==============================================================================
+   Function: isGreaterThan (used in divide like the two argument compare)
+==============================================================================
+*/
+   bool Column::isGreaterThan (const Column & right, int start)
+    {
+      if ((start > Length) || (start < 0)) return false;
+      return (compare(right, start) > 0);
+    }
+
+/*
+==============================================================================
+   Function: isGreaterThanOrEqualTo (used in divide)
+==============================================================================
+*/
+   bool Column::isGreaterThanOrEqualTo (const Column & right, int start)
+    {
+      if ((start > Length) || (start < 0)) return false;
+      return (compare(right, start) >= 0);
+    }
+
+/*
+==============================================================================
+   Function: left shift operator (achieves Column *= 10)
+==============================================================================
+*/
+   Column & Column::operator <<= (int shift)
+    {
+      if (Zero) return *this;
+      if (shift == 0) return *this;
+      if (shift < 0) return *this >>= -shift;
+      if (shift >= Length) release();
+      else
+       {
+         shiftUp(Limbs, limbs(), shift);
+         Limbs[0] %= tenTo[18 - pad()];
+         checkZero();
+       }
+      return *this;
+    } //operator <<=
+
+/*
+==============================================================================
+   Function: right shift operator (achieves Column /= 10)
+==============================================================================
+*/
+   Column & Column::operator >>= (int shift)
+    {
+      if (Zero) return *this;
+      if (shift == 0) return *this;
+      if (shift < 0) return *this <<= -shift;
+      if (shift >= Length) release();
+      else
+       {
+         shiftDown(Limbs, limbs(), shift);
+         checkZero();
+       }
+      return *this;
+    } //operator >>=
+
+/*
+==============================================================================
+   Function: digitAt
+------------------------------------------------------------------------------
+   NOTES:
+      Digits off either end are zero.
+==============================================================================
+*/
+   int Column::digitAt (int index) const
+    {
+      if (Zero || (index < 0) || (index >= Length)) return 0;
+      int at = index + pad();
+      return static_cast<int>(Limbs[at / 18] / tenTo[17 - at % 18] % 10);
+    }
+
+/*
+==============================================================================
+   Function: setDigit
+------------------------------------------------------------------------------
+   NOTES:
+      As with the unpacked Column, setting a digit does not test if that
+      makes the column zero.
+==============================================================================
+*/
+   int Column::setDigit (int index, int value)
+    {
+      if ((index < 0) || (index >= Length) || (value < 0) || (value > 9)) return -1;
+      if (Zero && (value == 0)) return 0;
+      if (Zero) allocate();
+      int at = index + pad();
+      uint64_t & limb = Limbs[at / 18];
+      uint64_t scale = tenTo[17 - at % 18];
+      limb -= (limb / scale % 10) * scale;
+      limb += static_cast<uint64_t>(value) * scale;
+      return value;
+    }
+
+/*
+==============================================================================
+   Function: addSubHelper
+------------------------------------------------------------------------------
+   NOTES:
+      This does all of the complex logic involved in doing a signed-magnitude
+      addition/subtraction. Either argument may be dest's own limbs.
+
+      The unpacked Column adds or subtracts all but the last digit, and the
+      result takes the left argument's last digit, so this does, too: the
+      last digit of each argument is taken out before the limbs are added or
+      subtracted, and the left one is put back.
+
+      An addition that overflows keeps the top Length digits of the sum, the
+      same truncation that the unpacked Column does.
+==============================================================================
+*/
+   void Column::addSubHelper (bool lSign, const uint64_t * left, bool rSign,
+      const uint64_t * right, Column & dest)
+    {
+      int n = dest.limbs();
+      uint64_t * to = dest.Limbs;
+      uint64_t lastLeft = left[n - 1] % 10, lastRight = right[n - 1] % 10;
+
+      if (lSign == rSign)
+       {
+         dest.Sign = lSign;
+         uint64_t carry = 0;
+         for (int i = n - 1; i >= 0; i--)
+          {
+            uint64_t sum = left[i] + right[i] + carry;
+            if (i == (n - 1)) sum -= lastRight;
+            carry = (sum >= Base) ? 1 : 0;
+            to[i] = carry ? (sum - Base) : sum;
+          }
+         dest.Overflow = (carry != 0) || (to[0] >= tenTo[18 - dest.pad()]);
+         if (dest.Overflow)
+          {
+            shiftDown(to, n, 1);
+            if (carry) to[0] += tenTo[17];
+          }
+       }
+      else
+       {
+         int res = basicCompare(left, right, n, 0, 0);
+         if (res == 0)
+          {
+            dest.Sign = false;
+            dest.release();
+            return;
+          }
+         const uint64_t * big = left, * small = right;
+         uint64_t lastBig = lastLeft, lastSmall = lastRight;
+         if (res < 0)
+          {
+            big = right;
+            small = left;
+            lastBig = lastRight;
+            lastSmall = lastLeft;
+          }
+         dest.Sign = (res > 0) ? lSign : rSign;
+         uint64_t borrow = 0;
+         for (int i = n - 1; i >= 0; i--)
+          {
+            uint64_t from = big[i], take = small[i] + borrow;
+            if (i == (n - 1))
+             {
+               from -= lastBig;
+               take -= lastSmall;
+             }
+            borrow = (from < take) ? 1 : 0;
+            to[i] = from + (borrow ? Base : 0) - take;
+          }
+         to[n - 1] += lastLeft;
+       }
+    } //addSubHelper
+
+/*
+==============================================================================
+   Function: add and assign operator
+------------------------------------------------------------------------------
+   NOTES:
+      This function will only work on Columns of the same size.
+==============================================================================
+*/
+   Column & Column::operator += (const Column & right)
+    {
+      if ((Length != right.Length) || right.Zero) return *this; //do nothing
+      if (Zero)
+       {
+         allocate();
+         memcpy(Limbs, right.Limbs, limbs() * sizeof(uint64_t));
+         Sign = right.Sign;
+         Overflow = false;
+       }
+      else addSubHelper(Sign, Limbs, right.Sign, right.Limbs, *this);
+      return *this;
+    }
+
+/*
+==============================================================================
+   Function: subtract and assign operator
+------------------------------------------------------------------------------
+   NOTES:
+      This function will only work on Columns of the same size.
+==============================================================================
+*/
+   Column & Column::operator -= (const Column & right)
+    {
+      if ((Length != right.Length) || right.Zero) return *this; //do nothing
+      if (Zero)
+       {
+         allocate();
+         memcpy(Limbs, right.Limbs, limbs() * sizeof(uint64_t));
+         Sign = !right.Sign;
+         Overflow = false;
+       }
+      else addSubHelper(Sign, Limbs, !right.Sign, right.Limbs, *this);
+      return *this;
+    }
+
+/*
+==============================================================================
+   Function: addition operator
+------------------------------------------------------------------------------
+   NOTES:
+      This function will only work on Columns of the same size.
+==============================================================================
+*/
+   Column Column::operator + (const Column & right) const
+    {
+      Column tempColumn (*this);
+      return tempColumn += right;
+    }
+
+/*
+==============================================================================
+   Function: subtraction operator
+------------------------------------------------------------------------------
+   NOTES:
+      This function will only work on Columns of the same size.
+==============================================================================
+*/
+   Column Column::operator - (const Column & right) const
+    {
+      Column tempColumn (*this);
+      return tempColumn -= right;
+    }
+
+/*
+==============================================================================
+   Function: assignment operator
+==============================================================================
+*/
+   Column & Column::operator = (const Column & right)
+    {
+      if (&right == this) return *this;
+      if (right.Zero) release();
+      else
+       {
+         if (Limbs && (right.limbs() != limbs()))
+          {
+            drop(Limbs, limbs() * sizeof(uint64_t));
+            Limbs = NULL;
+          }
+         if (!Limbs) Limbs = static_cast<uint64_t *>(grab(right.limbs() * sizeof(uint64_t)));
+         memcpy(Limbs, right.Limbs, right.limbs() * sizeof(uint64_t));
+       }
+      Sign = right.Sign;
+      Length = right.Length;
+      Zero = right.Zero;
+      Overflow = right.Overflow;
+      return *this;
+    } //operator = (Column)
+
+/*
+==============================================================================
+   Function: left justified assignment operator
+------------------------------------------------------------------------------
+   NOTES:
+      A longer right is cut off on the right, a shorter one padded with
+      zeros: right is scaled by ten to the difference in length.
+==============================================================================
+*/
+   Column & Column::operator |= (const Column & right)
+    {
+      if (&right == this) return *this;
+      Sign = right.Sign;
+      if (right.Zero && Zero) return *this;
+      if (right.Zero)
+       {
+         if (right.Length < Length)
+          {
+            clearDigits(Limbs, pad(), 0, right.Length);
+            checkZero();
+          }
+         else release();
+       }
+      else
+       {
+         if (Zero) allocate();
+         if (right.Length <= Length)
+          {
+            place(right.Limbs, right.limbs(), Limbs, limbs());
+            shiftUp(Limbs, limbs(), Length - right.Length);
+          }
+         else
+          {
+            uint64_t * temp = static_cast<uint64_t *>(grab(right.limbs() * sizeof(uint64_t)));
+            memcpy(temp, right.Limbs, right.limbs() * sizeof(uint64_t));
+            shiftDown(temp, right.limbs(), right.Length - Length);
+            place(temp, right.limbs(), Limbs, limbs());
+            drop(temp, right.limbs() * sizeof(uint64_t));
+          }
+       }
+      return *this;
+    } //operator |=
+
+/*
+==============================================================================
+   Function: right justified assignment statement
+------------------------------------------------------------------------------
+   NOTES:
+      Division uses this to assign the divisor to a variable representing
+      the stopping criteria.
+
+      This function will only work if the length of the argument being
+      assigned is less than the length of the Column it is assigned to.
+==============================================================================
+*/
+   Column & Column::operator &= (const Column & right)
+    {
+      if (&right == this) return *this;
+      Sign = right.Sign;
+      if (right.Length > Length) return *this;
+      if (right.Zero && Zero) return *this;
+      if (right.Zero)
+       {
+         clearDigits(Limbs, pad(), Length - right.Length, Length);
+         checkZero();
+       }
+      else
+       {
+         if (Zero) allocate();
+         place(right.Limbs, right.limbs(), Limbs, limbs());
+       }
+      return *this;
+    } //operator &=
+
+/*
+==============================================================================
+   Function: zero-padded left-justified assignment statement
+------------------------------------------------------------------------------
+   NOTES:
+      Division will use this to assign the divisor and dividend to temporary
+      variables.
+
+      This function will only work if the length of the argument being
+      assigned is less than the length of the Column it is assigned to.
+==============================================================================
+*/
+   Column & Column::operator *= (const Column & right)
+    {
+      if (&right == this) return *this;
+      Sign = right.Sign;
+      if (right.Length >= Length) return *this;
+      if (right.Zero && Zero) return *this;
+      if (right.Zero)
+       {
+         clearDigits(Limbs, pad(), 0, right.Length + 1);
+         checkZero();
+       }
+      else
+       {
+         if (Zero) allocate();
+         place(right.Limbs, right.limbs(), Limbs, limbs());
+         shiftUp(Limbs, limbs(), Length - right.Length - 1);
+       }
+      return *this;
+    } //operator *=
+
+/*
+==============================================================================
+   Function: increment operator
+------------------------------------------------------------------------------
+   NOTES:
+      Rounding will use this.
+
+      Increments away from zero. A Column of all 9's becomes 1 followed by
+      0's and sets Overflow.
+==============================================================================
+*/
+   Column Column::operator++ (int)
+    {
+      if (Zero)
+       {
+         allocate();
+         Limbs[limbs() - 1] = 1;
+       }
+      else
+       {
+         int n = limbs();
+         uint64_t carry = 1;
+         for (int i = n - 1; (i >= 0) && (carry != 0); i--)
+          {
+            if (++Limbs[i] == Base) Limbs[i] = 0;
+            else carry = 0;
+          }
+         if ((carry != 0) || (Limbs[0] >= tenTo[18 - pad()]))
+          {
+            memset(Limbs, 0, n * sizeof(uint64_t));
+            Limbs[0] = tenTo[17 - pad()];
+            Overflow = true;
+          }
+       }
+      return Column(*this);
+    }
+
+/*
+==============================================================================
+   Function: incrementAt
+------------------------------------------------------------------------------
+   INPUT: digit index to increment at
+   NOTES:
+      Increments away from zero.
+
+      Rounding and divide will use this.
+==============================================================================
+*/
+   void Column::incrementAt (int digit)
+    {
+      if ((digit < 0) || (digit >= Length)) return;
+      if (Zero) allocate();
+      int at = digit + pad();
+      uint64_t carry = tenTo[17 - at % 18];
+      for (int i = at / 18; (i >= 0) && (carry != 0); i--)
+       {
+         Limbs[i] += carry;
+         if (Limbs[i] >= Base)
+          {
+            Limbs[i] -= Base;
+            carry = 1;
+          }
+         else carry = 0;
+       }
+      uint64_t top = tenTo[18 - pad()];
+      if ((carry != 0) || (Limbs[0] >= top))
+       {
+            //We ran off of the end: drop the carry and put it back as
+            //the first digit of the number shifted down by one
+         if (carry == 0) Limbs[0] -= top;
+         shiftDown(Limbs, limbs(), 1);
+         Limbs[0] += tenTo[17 - pad()];
+         Overflow = true;
+       }
+    } //incrementAt
+
+/*
+==============================================================================
+   Function: product
+------------------------------------------------------------------------------
+   NOTES:
+      Multiplies limb by limb, summing each column of partial products
+      before carrying (Comba's method), so it only divides by 10^18 twice
+      per limb of result. A column is reduced every so often, as only 340
+      partial products fit in a Wide.
+
+      Only the low limbs that fit this Column are computed. The sign is
+      the xor of the signs of the arguments.
+==============================================================================
+*/
+   void Column::product (const Column & left, const Column & right)
+    {
+      Sign = (left.Sign != right.Sign);
+      Overflow = false;
+      if (left.Zero || right.Zero)
+       {
+         release();
+         return;
+       }
+
+      int ln = left.limbs(), rn = right.limbs(), n = limbs();
+      int total = (ln + rn < n) ? (ln + rn) : n;
+      uint64_t * result = static_cast<uint64_t *>(grab(total * sizeof(uint64_t)));
+
+         //Columns are counted from the least significant limb
+      const uint64_t * l = left.Limbs + ln - 1, * r = right.Limbs + rn - 1;
+      Wide carry = 0;
+      for (int k = 0; k < total; k++)
+       {
+         Wide column = carry;
+         carry = 0;
+         int first = (k >= rn) ? (k - rn + 1) : 0, last = (k < ln) ? k : (ln - 1);
+         for (int i = first, count = 0; i <= last; i++)
+          {
+            column += static_cast<Wide>(*(l - i)) * *(r - (k - i));
+            if (++count == 256)
+             {
+               carry += column / Base;
+               column %= Base;
+               count = 0;
+             }
+          }
+         carry += column / Base;
+         result[total - 1 - k] = static_cast<uint64_t>(column % Base);
+       }
+
+      if (Zero) allocate();
+      place(result, total, Limbs, n);
+      Limbs[0] %= tenTo[18 - pad()];
+      drop(result, total * sizeof(uint64_t));
+      checkZero();
+    } //product
+
+ } //namespace Col
+
+#endif /* COLUMN_PACKED */
@@ -1,2 +1,2 @@
-x86_64-w64-mingw32-g++.exe -s -O6 -Wall -Wextra -Wpedantic -Wconversion -o Calc2 main.cpp Calculator.cpp Column.cpp Float.cpp Round.cpp Stack.cpp Functions.cpp Constants.cpp rand850.c
-x86_64-w64-mingw32-g++.exe -s -O6 -Wall -Wextra -Wpedantic -Wconversion -o Calc -DMODE_2 main.cpp Calculate.cpp Column.cpp Float.cpp Round.cpp Stack.cpp Functions.cpp Constants.cpp rand850.c
+x86_64-w64-mingw32-g++.exe -s -O6 -Wall -Wextra -Wpedantic -Wconversion -o Calc2 main.cpp Calculator.cpp Column.cpp PackedColumn.cpp Float.cpp Round.cpp Stack.cpp Functions.cpp Constants.cpp rand850.c
+x86_64-w64-mingw32-g++.exe -s -O6 -Wall -Wextra -Wpedantic -Wconversion -o Calc -DMODE_2 main.cpp Calculate.cpp Column.cpp PackedColumn.cpp Float.cpp Round.cpp Stack.cpp Functions.cpp Constants.cpp rand850.c